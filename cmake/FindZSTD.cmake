@@ -0,0 +1,68 @@
+#[=======================================================================[.rst:
+FindZSTD
+--------
+
+Finds the Zstandard library.
+
+Result Variables
+^^^^^^^^^^^^^^^^
+
+This will define the following variables:
+
+``ZSTD_FOUND``
+  True if the system has the Zstandard library.
+``ZSTD_INCLUDE_DIRS``
+  Include directories needed to use ZSTD.
+``ZSTD_LIBRARIES``
+  Libraries needed to link to ZSTD.
+``ZSTD_VERSION``
+  The version of the Zstandard library which was found.
+
+Cache Variables
+^^^^^^^^^^^^^^^
+
+The following cache variables may also be set:
+
+``ZSTD_INCLUDE_DIR``
+  The directory containing ``zstd.h``.
+``ZSTD_LIBRARY``
+  The path to the Zstandard library.
+
+#]=======================================================================]
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_ZSTD QUIET libzstd)
+
+find_path(ZSTD_INCLUDE_DIR
+    NAMES zstd.h
+    PATHS ${PC_ZSTD_INCLUDE_DIRS}
+)
+
+find_library(ZSTD_LIBRARY
+    NAMES zstd
+    PATHS ${PC_ZSTD_LIBRARY_DIRS}
+)
+
+include(FixVcpkgLibrary)
+FixVcpkgLibrary(ZSTD)
+
+set(ZSTD_VERSION ${PC_ZSTD_VERSION})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD
+    FOUND_VAR ZSTD_FOUND
+    REQUIRED_VARS
+        ZSTD_LIBRARY
+        ZSTD_INCLUDE_DIR
+    VERSION_VAR ZSTD_VERSION
+)
+
+if(ZSTD_FOUND)
+    set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+    set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+endif()
+
+mark_as_advanced(
+    ZSTD_INCLUDE_DIR
+    ZSTD_LIBRARY
+)
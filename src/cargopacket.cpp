@@ -14,6 +14,10 @@
 #include "economy_base.h"
 #include "cargoaction.h"
 #include "order_type.h"
+#include "vehicle_base.h"
+#include "timer/timer.h"
+#include "timer/timer_game_economy.h"
+#include "debug.h"
 
 #include "safeguards.h"
 
@@ -153,6 +157,37 @@ void CargoPacket::Reduce(uint count)
 	}
 }
 
+/**
+ * Merge compatible cargo packets in all vehicle and station cargo lists.
+ * Packets are only merged when the result is indistinguishable from the
+ * separate packets for payment, routing and aging, so this only reduces
+ * the size of the cargo packet pool.
+ */
+/* static */ void CargoPacket::CompactAll()
+{
+	size_t before = CargoPacket::GetNumItems();
+	uint merged = 0;
+
+	for (Vehicle *v : Vehicle::Iterate()) {
+		merged += v->cargo.Compact();
+	}
+
+	for (Station *st : Station::Iterate()) {
+		for (GoodsEntry &ge : st->goods) {
+			if (!ge.HasData()) continue;
+			merged += ge.GetData().cargo.Compact();
+		}
+	}
+
+	Debug(misc, 1, "Compacted cargo packets: {} before, {} merged, {} after", before, merged, CargoPacket::GetNumItems());
+}
+
+/** Economy monthly loop for compacting cargo packets. */
+static const IntervalTimer<TimerGameEconomy> _economy_cargo_packets_monthly({TimerGameEconomy::Trigger::Month, TimerGameEconomy::Priority::CargoPacket}, [](auto)
+{
+	CargoPacket::CompactAll();
+});
+
 /*
  *
  * Cargo list implementation
@@ -237,6 +272,43 @@ template <class Tinst, class Tcont>
 	}
 }
 
+/**
+ * Merge all packets in the given list which only differ in amount and feeder
+ * share into the first of them. The relative order of the remaining packets is
+ * kept. The caches of the list stay valid as the amount, feeder share and
+ * periods in transit of the merged cargo don't change.
+ * @param packets List of packets to compact.
+ * @return Number of packets that were merged away.
+ */
+template <class Tinst, class Tcont>
+/* static */ uint CargoList<Tinst, Tcont>::CompactPackets(std::list<CargoPacket *> &packets)
+{
+	if (packets.size() < 2) return 0;
+
+	using Key = std::tuple<TileIndex, uint16_t, StationID, Source, StationID, int16_t, int16_t>;
+	std::map<Key, CargoPacket *> targets;
+
+	uint merged = 0;
+	for (auto it = packets.begin(); it != packets.end();) {
+		CargoPacket *cp = *it;
+		Key key{cp->source_xy, cp->periods_in_transit, cp->first_station, cp->source, cp->next_hop, cp->travelled.x, cp->travelled.y};
+		auto [target, inserted] = targets.try_emplace(key, cp);
+		if (!inserted) {
+			CargoPacket *icp = target->second;
+			if (icp->count + cp->count <= CargoPacket::MAX_COUNT) {
+				icp->Merge(cp);
+				it = packets.erase(it);
+				merged++;
+				continue;
+			}
+			/* The previous packet is full; further cargo goes into this one. */
+			target->second = cp;
+		}
+		++it;
+	}
+	return merged;
+}
+
 /*
  *
  * Vehicle cargo list implementation.
@@ -674,6 +746,18 @@ uint VehicleCargoList::Reroute(uint max_move, VehicleCargoList *dest, StationID
 	return max_move;
 }
 
+/**
+ * Merges compatible packets in this list. This is only done if all cargo is
+ * designated to be kept, so the ranges of packets for the different actions
+ * don't need to be considered.
+ * @return Number of packets that were merged away.
+ */
+uint VehicleCargoList::Compact()
+{
+	if (this->action_counts[MTA_KEEP] != this->count) return 0;
+	return Parent::CompactPackets(this->packets);
+}
+
 /*
  *
  * Station cargo list implementation.
@@ -864,6 +948,19 @@ uint StationCargoList::Reroute(uint max_move, StationCargoList *dest, StationID
 	return this->ShiftCargo(StationCargoReroute(this, dest, max_move, avoid, avoid2, ge), {&avoid, 1}, false);
 }
 
+/**
+ * Merges compatible packets with the same next hop in this list.
+ * @return Number of packets that were merged away.
+ */
+uint StationCargoList::Compact()
+{
+	uint merged = 0;
+	for (auto &[next, list] : static_cast<StationCargoPacketMap::Map &>(this->packets)) {
+		merged += Parent::CompactPackets(list);
+	}
+	return merged;
+}
+
 /*
  * We have to instantiate everything we want to be usable.
  */
@@ -264,6 +264,7 @@ public:
 	static void InvalidateAllFrom(Source src);
 	static void InvalidateAllFrom(StationID sid);
 	static void AfterLoad();
+	static void CompactAll();
 };
 
 /**
@@ -305,6 +306,8 @@ protected:
 
 	static bool TryMerge(CargoPacket *cp, CargoPacket *icp);
 
+	static uint CompactPackets(std::list<CargoPacket *> &packets);
+
 public:
 	/** Create the cargo list. */
 	CargoList() {}
@@ -494,6 +497,8 @@ public:
 	uint Truncate(uint max_move = UINT_MAX);
 	uint Reroute(uint max_move, VehicleCargoList *dest, StationID avoid, StationID avoid2, const GoodsEntry *ge);
 
+	uint Compact();
+
 	/**
 	 * Are the two CargoPackets mergeable in the context of
 	 * a list of CargoPackets for a Vehicle?
@@ -608,6 +613,8 @@ public:
 	uint Truncate(uint max_move = UINT_MAX, StationCargoAmountMap *cargo_per_source = nullptr);
 	uint Reroute(uint max_move, StationCargoList *dest, StationID avoid, StationID avoid2, const GoodsEntry *ge);
 
+	uint Compact();
+
 	/**
 	 * Are the two CargoPackets mergeable in the context of
 	 * a list of CargoPackets for a Station?
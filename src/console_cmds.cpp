@@ -15,11 +15,14 @@
 #include "landscape.h"
 #include "saveload/saveload.h"
 #include "network/core/network_game_info.h"
+#include "network/core/packet.h"
 #include "network/network.h"
 #include "network/network_func.h"
 #include "network/network_base.h"
 #include "network/network_admin.h"
 #include "network/network_client.h"
+#include "network/network_loadtest.h"
+#include "network/network_replay.h"
 #include "command_func.h"
 #include "settings_func.h"
 #include "fios.h"
@@ -29,6 +32,7 @@
 #include "genworld.h"
 #include "strings_func.h"
 #include "viewport_func.h"
+#include "viewport_sprite_sorter.h"
 #include "window_func.h"
 #include "timer/timer.h"
 #include "company_func.h"
@@ -45,6 +49,8 @@
 #include "3rdparty/fmt/chrono.h"
 #include "company_cmd.h"
 #include "misc_cmd.h"
+#include "linkgraph/linkgraphjob.h"
+#include "linkgraph/linkgraphschedule.h"
 
 #if defined(WITH_ZLIB)
 #include "network/network_content.h"
@@ -913,6 +919,133 @@ static bool ConStatus(std::span<std::string_view> argv)
 	return true;
 }
 
+/** Show the work done for transferring packets. @copydoc IConsoleCmdProc */
+static bool ConPacketStats(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show how many packet buffers were allocated and how many send calls were made, in the last tick and in total. Usage 'packet_stats'.");
+		return true;
+	}
+
+	auto print = [](std::string_view title, const PacketCounters &counters) {
+		IConsolePrint(CC_DEFAULT, "{:<10} {:>10} buffers allocated, {:>10} reused, {:>10} packets sent in {:>10} send calls",
+			title, counters.buffers_allocated, counters.buffers_reused, counters.packets_sent, counters.send_calls);
+	};
+	print("Last tick:", NetworkGetPacketCountersOfTick());
+	print("Total:", GetPacketCounters());
+	return true;
+}
+
+/** Start or stop recording a replay. @copydoc IConsoleCmdProc */
+static bool ConReplayRecord(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Record the game from now on, so it can be replayed with 'replay'. Usage: 'replay_record <filename> | stop'.");
+		IConsolePrint(CC_HELP, "The replay contains a savegame and all commands that are executed, until the recording is stopped or another game is started.");
+		return true;
+	}
+
+	if (argv.size() != 2) return false;
+
+	if (argv[1] == "stop") {
+		if (!NetworkReplayIsRecording()) {
+			IConsolePrint(CC_ERROR, "No replay is being recorded.");
+			return true;
+		}
+		NetworkReplayStopRecording();
+		IConsolePrint(CC_INFO, "Stopped recording the replay.");
+		return true;
+	}
+
+	std::string filename = fmt::format("{}.replay", argv[1]);
+	if (!NetworkReplayStartRecording(filename)) {
+		IConsolePrint(CC_ERROR, "Recording the replay to '{}' failed.", filename);
+	} else {
+		IConsolePrint(CC_INFO, "Recording the replay to '{}'.", filename);
+	}
+	return true;
+}
+
+/** Play a replay at maximum speed. @copydoc IConsoleCmdProc */
+static bool ConReplay(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Load and play a replay as fast as possible, checking the game state after every tick. Usage: 'replay <filename> [<ticks>]'.");
+		IConsolePrint(CC_HELP, "When given, the replay stops after the given number of ticks, so the game can be inspected or saved at that point.");
+		return true;
+	}
+
+	if (argv.size() < 2 || argv.size() > 3) return false;
+
+	uint32_t max_ticks = UINT32_MAX;
+	if (argv.size() == 3) {
+		auto ticks = ParseType<uint32_t>(argv[2]);
+		if (!ticks.has_value()) return false;
+		max_ticks = *ticks;
+	}
+
+	if (!_network_dedicated) {
+		IConsolePrint(CC_ERROR, "Replays can only be played on a dedicated server.");
+		return true;
+	}
+	if (HasClients()) {
+		IConsolePrint(CC_ERROR, "Replays cannot be played while clients are connected.");
+		return true;
+	}
+	if (NetworkReplayIsRecording()) {
+		IConsolePrint(CC_ERROR, "Replays cannot be played while recording one.");
+		return true;
+	}
+
+	std::string filename = fmt::format("{}.replay", argv[1]);
+	if (NetworkReplayPlay(filename, max_ticks)) IConsolePrint(CC_INFO, "The replay stayed in sync.");
+	return true;
+}
+
+/** Start, stop or show simulated clients to put load on a local server. @copydoc IConsoleCmdProc */
+static bool ConLoadClients(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Connect simulated clients to a server on this machine. Usage: 'load_clients <count> [<companies> [<commands per minute> [<port>]]]' or 'load_clients status | stop'.");
+		IConsolePrint(CC_HELP, "The clients join and download the map, but do not run the game. The first <companies> of them start a new company; all send random commands at the given rate.");
+		IConsolePrint(CC_HELP, "Without a port they join the server of this process; 'status' shows their state, the traffic and, for that server, their lag.");
+		return true;
+	}
+
+	if (argv.size() < 2 || argv.size() > 5) return false;
+
+	if (argv[1] == "status") {
+		LoadTestNetworkGameSocketHandler::PrintStatus();
+		return true;
+	}
+	if (argv[1] == "stop") {
+		NetworkLoadTestStop();
+		IConsolePrint(CC_INFO, "Stopped all simulated clients.");
+		return true;
+	}
+
+	auto count = ParseType<uint>(argv[1]);
+	auto companies = argv.size() > 2 ? ParseType<uint>(argv[2]) : 0;
+	auto commands_per_minute = argv.size() > 3 ? ParseType<uint>(argv[3]) : 60;
+	auto port = argv.size() > 4 ? ParseType<uint16_t>(argv[4]) : _settings_client.network.server_port;
+	if (!count.has_value() || !companies.has_value() || !commands_per_minute.has_value() || !port.has_value()) return false;
+
+	/* Each client needs a socket, and those are checked with select(). */
+	if (*count == 0 || *count > MAX_CLIENTS) {
+		IConsolePrint(CC_ERROR, "The number of clients must be between 1 and {}.", MAX_CLIENTS);
+		return true;
+	}
+	if (!_network_available) {
+		IConsolePrint(CC_ERROR, "The network is not available.");
+		return true;
+	}
+
+	if (NetworkLoadTestStart(*count, *companies, *commands_per_minute, *port)) {
+		IConsolePrint(CC_INFO, "Connecting {} simulated clients to port {}.", *count, *port);
+	}
+	return true;
+}
+
 /** Get information like client/company count/limits for the server. @copydoc IConsoleCmdProc */
 static bool ConServerInfo(std::span<std::string_view> argv)
 {
@@ -2778,6 +2911,118 @@ static bool ConFramerateWindow(std::span<std::string_view> argv)
 	return true;
 }
 
+/** Show the running and recently finished link graph jobs. @copydoc IConsoleCmdProc */
+static bool ConLinkGraphSchedule(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show running and recently finished link graph jobs with their predicted and actual run time. Usage: 'linkgraph_schedule'.");
+		return true;
+	}
+
+	const LinkGraphSchedule &schedule = LinkGraphSchedule::instance;
+	/* The prediction is based on measurements on this machine only, it is purely informational. */
+	double us_per_cost = schedule.GetMicrosecondsPerCost();
+
+	IConsolePrint(CC_INFO, "Running jobs:");
+	for (const LinkGraphJob *job : schedule.GetRunning()) {
+		IConsolePrint(CC_DEFAULT, "  graph {:>5}  cargo {:>2}  nodes {:>5}  cost {:>12}  join date {}  predicted {:.1f} ms",
+			job->LinkGraphIndex(), job->Cargo(), job->Size(), job->Cost(), job->JoinDate(), job->Cost() * us_per_cost / 1000);
+	}
+
+	IConsolePrint(CC_INFO, "Recently finished jobs:");
+	for (const LinkGraphSchedule::JobRecord &record : schedule.GetHistory()) {
+		IConsolePrint(CC_DEFAULT, "  graph {:>5}  cargo {:>2}  nodes {:>5}  cost {:>12}  duration {:>3} days  predicted {:.1f} ms  actual {:.1f} ms",
+			record.link_graph, record.cargo, record.nodes, record.cost, record.duration,
+			record.cost * us_per_cost / 1000, record.run_time.count() / 1000.0);
+	}
+	return true;
+}
+
+/**
+ * Print the profile of a saved or loaded game.
+ * @param what Whether it is the profile of a "save" or "load".
+ * @param profile The profile to print.
+ */
+static void PrintSaveLoadProfile(std::string_view what, const SaveLoadProfile &profile)
+{
+	if (!profile.valid) {
+		IConsolePrint(CC_INFO, "No game has been {}d yet.", what);
+		return;
+	}
+
+	auto ms = [](std::chrono::steady_clock::duration d) { return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / 1000.0; };
+
+	IConsolePrint(CC_INFO, "Last {}: {} bytes, {} bytes compressed with {}; chunks {:.1f} ms{}", what, profile.size, profile.compressed_size, profile.format,
+		ms(profile.chunks_time), what == "save" ? fmt::format(", compressing and writing {:.1f} ms", ms(profile.write_time)) : "");
+
+	/* Biggest chunks first, as those are the ones worth looking at. */
+	std::vector<const SaveLoadChunkProfile *> chunks;
+	for (const SaveLoadChunkProfile &chunk : profile.chunks) chunks.push_back(&chunk);
+	std::ranges::stable_sort(chunks, std::greater{}, &SaveLoadChunkProfile::size);
+
+	IConsolePrint(CC_DEFAULT, "  Chunk       Bytes   Share  Compressed   Share     Time");
+	for (const SaveLoadChunkProfile *chunk : chunks) {
+		double share = profile.size == 0 ? 0 : 100.0 * chunk->size / profile.size;
+		if (what == "save") {
+			double compressed_share = profile.compressed_size == 0 ? 0 : 100.0 * chunk->compressed_size / profile.compressed_size;
+			IConsolePrint(CC_DEFAULT, "  {:<5} {:>11} {:>6.2f}% {:>11} {:>6.2f}% {:>6.1f} ms", chunk->name, chunk->size, share, chunk->compressed_size, compressed_share, ms(chunk->time));
+		} else {
+			IConsolePrint(CC_DEFAULT, "  {:<5} {:>11} {:>6.2f}% {:>11} {:>7} {:>6.1f} ms", chunk->name, chunk->size, share, "-", "-", ms(chunk->time));
+		}
+	}
+
+	if (profile.afterload.empty()) return;
+
+	IConsolePrint(CC_DEFAULT, "  AfterLoadGame:");
+	for (const auto &[name, time] : profile.afterload) {
+		IConsolePrint(CC_DEFAULT, "    {:<22} {:>8.1f} ms", name, ms(time));
+	}
+}
+
+/** Show how much space and time each chunk took in the last saved and loaded game. @copydoc IConsoleCmdProc */
+static bool ConSaveProfile(std::span<std::string_view> argv)
+{
+	if (argv.empty() || argv.size() > 2 || (argv.size() == 2 && argv[1] != "save" && argv[1] != "load")) {
+		IConsolePrint(CC_HELP, "Show the size and time of each chunk of the last saved and loaded game. Usage: 'save_profile [save|load]'.");
+		IConsolePrint(CC_HELP, "Compressed sizes of chunks are approximate, as compressors buffer their data.");
+		return true;
+	}
+
+	if (argv.size() == 1 || argv[1] == "save") PrintSaveLoadProfile("save", GetSaveProfile());
+	if (argv.size() == 1 || argv[1] == "load") PrintSaveLoadProfile("load", GetLoadProfile());
+	return true;
+}
+
+/** Capture the sprites sorted for drawing the screen, or replay a capture with every sprite sorter. @copydoc IConsoleCmdProc */
+static bool ConSpriteSorting(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Benchmark the sorting of sprites in viewports. Usage: 'sprite_sorting capture' or 'sprite_sorting benchmark <file> [<iterations>]'.");
+		IConsolePrint(CC_HELP, "'capture' writes the sprites that get sorted while drawing the whole screen to a file in the screenshot directory.");
+		IConsolePrint(CC_HELP, "'benchmark' sorts the sprites of such a file with each sorter, and shows the time it took and whether the orders are the same.");
+		return true;
+	}
+
+	if (argv.size() == 2 && argv[1] == "capture") {
+		if (_network_dedicated) {
+			IConsolePrint(CC_ERROR, "A dedicated server does not draw the screen.");
+			return true;
+		}
+		CaptureSpriteSorting();
+		return true;
+	}
+
+	if ((argv.size() == 3 || argv.size() == 4) && argv[1] == "benchmark") {
+		auto iterations = argv.size() == 4 ? ParseType<uint>(argv[3]) : 10;
+		if (!iterations.has_value() || *iterations == 0) return false;
+
+		BenchmarkSpriteSorters(std::string(argv[2]), *iterations);
+		return true;
+	}
+
+	return false;
+}
+
 /**
  * Format a label as a string.
  * If all elements are visible ASCII (excluding space) then the label will be formatted as a string of 4 characters,
@@ -3048,6 +3293,10 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("connect",                 ConNetworkConnect,   ConHookClientOnly);
 	IConsole::CmdRegister("clients",                 ConNetworkClients,   ConHookNeedNetwork);
 	IConsole::CmdRegister("status",                  ConStatus,           ConHookServerOnly);
+	IConsole::CmdRegister("packet_stats",            ConPacketStats,      ConHookNeedNetwork);
+	IConsole::CmdRegister("replay_record",           ConReplayRecord,     ConHookServerOnly);
+	IConsole::CmdRegister("replay",                  ConReplay,           ConHookServerOnly);
+	IConsole::CmdRegister("load_clients",            ConLoadClients);
 	IConsole::CmdRegister("server_info",             ConServerInfo,       ConHookServerOnly);
 	IConsole::AliasRegister("info",                  "server_info");
 	IConsole::CmdRegister("reconnect",               ConNetworkReconnect, ConHookClientOnly);
@@ -3095,6 +3344,9 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("linkgraph_schedule",      ConLinkGraphSchedule);
+	IConsole::CmdRegister("save_profile",            ConSaveProfile);
+	IConsole::CmdRegister("sprite_sorting",          ConSpriteSorting);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
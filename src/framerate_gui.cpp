@@ -166,6 +166,32 @@ namespace {
 			return sumtime * 1000 / count / TIMESTAMP_PRECISION;
 		}
 
+		/**
+		 * Get percentiles of the cycle processing time over a number of data points.
+		 * @param count The number of cycles to process.
+		 * @return The percentiles in microseconds.
+		 */
+		PerformancePercentiles GetDurationPercentiles(int count)
+		{
+			count = std::min(count, this->num_valid);
+
+			int first_point = this->prev_index - count;
+			if (first_point < 0) first_point += NUM_FRAMERATE_POINTS;
+
+			/* Collect the durations, skipping invalid points */
+			std::vector<TimingMeasurement> sorted;
+			sorted.reserve(count);
+			for (int i = first_point; i < first_point + count; i++) {
+				auto d = this->durations[i % NUM_FRAMERATE_POINTS];
+				if (d != INVALID_DURATION) sorted.push_back(d);
+			}
+			if (sorted.empty()) return {};
+
+			std::ranges::sort(sorted);
+			auto percentile = [&sorted](size_t p) { return sorted[(sorted.size() - 1) * p / 100]; };
+			return {percentile(50), percentile(90), percentile(99), sorted.back()};
+		}
+
 		/**
 		 * Get current rate of a performance element, based on approximately the past one second of data.
 		 * @return The recent rate of the performance element.
@@ -260,6 +286,18 @@ static TimingMeasurement GetPerformanceTimer()
 	return (TimingMeasurement)time_point_cast<microseconds>(high_resolution_clock::now()).time_since_epoch().count();
 }
 
+/**
+ * Get percentiles of the processing time of a performance element.
+ * @param elem The element to get the percentiles of.
+ * @param count The number of most recent cycles to consider.
+ * @return The percentiles, in microseconds.
+ */
+PerformancePercentiles GetPerformancePercentiles(PerformanceElement elem, int count)
+{
+	static_assert(TIMESTAMP_PRECISION == 1000000);
+	return _pf_data[elem].GetDurationPercentiles(count);
+}
+
 
 /**
  * Begin a cycle of a measured element.
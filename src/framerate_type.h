@@ -119,6 +119,16 @@ public:
 	static void Reset(PerformanceElement elem);
 };
 
+/** Percentiles of the processing time of a performance element, in microseconds. */
+struct PerformancePercentiles {
+	TimingMeasurement p50 = 0; ///< Median processing time.
+	TimingMeasurement p90 = 0; ///< 90th percentile of the processing time.
+	TimingMeasurement p99 = 0; ///< 99th percentile of the processing time.
+	TimingMeasurement max = 0; ///< Longest processing time.
+};
+
+PerformancePercentiles GetPerformancePercentiles(PerformanceElement elem, int count);
+
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
 
@@ -52,7 +52,7 @@ PauseModes _pause_mode;
 GameSessionStats _game_session_stats; ///< Statistics about the current session.
 
 static uint8_t _stringwidth_table[FS_END][224]; ///< Cache containing width of often used characters. @see GetCharacterWidth()
-DrawPixelInfo *_cur_dpi;
+thread_local DrawPixelInfo *_cur_dpi; ///< The area to draw on; per thread, as parts of viewports are drawn by multiple threads.
 
 static void GfxMainBlitterViewport(const Sprite *sprite, int x, int y, BlitterMode mode, const SubSprite *sub = nullptr, SpriteID sprite_id = SPR_CURSOR_MOUSE);
 static void GfxMainBlitter(const Sprite *sprite, int x, int y, BlitterMode mode, const SubSprite *sub = nullptr, SpriteID sprite_id = SPR_CURSOR_MOUSE, ZoomLevel zoom = ZoomLevel::Min);
@@ -72,8 +72,8 @@ int _gui_scale_cfg;                         ///< GUI scale in config.
  * @ingroup dirty
  */
 static Rect _invalid_rect;
-static const uint8_t *_colour_remap_ptr;
-static uint8_t _string_colourremap[3]; ///< Recoloursprite for stringdrawing. The grf loader ensures that #SpriteType::Font sprites only use colours 0 to 2.
+static thread_local const uint8_t *_colour_remap_ptr;
+static thread_local uint8_t _string_colourremap[3]; ///< Recoloursprite for stringdrawing. The grf loader ensures that #SpriteType::Font sprites only use colours 0 to 2.
 
 static const uint DIRTY_BLOCK_HEIGHT   = 8;
 static const uint DIRTY_BLOCK_WIDTH    = 64;
@@ -1026,6 +1026,21 @@ void DrawSpriteViewport(SpriteID img, PaletteID pal, int x, int y, const SubSpri
 	}
 }
 
+/**
+ * Load the sprites #DrawSpriteViewport needs for a sprite into the sprite cache,
+ * so drawing it does not have to load anything.
+ * @param img Image number to draw.
+ * @param pal Palette to use.
+ * @see SpriteCacheSharedReads
+ */
+void PrefetchSpriteViewport(SpriteID img, PaletteID pal)
+{
+	GetSprite(GB(img, 0, SPRITE_WIDTH), SpriteType::Normal);
+	if (HasBit(img, PALETTE_MODIFIER_TRANSPARENT) || (pal != PAL_NONE && !HasBit(pal, PALETTE_TEXT_RECOLOUR))) {
+		GetNonSprite(GB(pal, 0, PALETTE_WIDTH), SpriteType::Recolour);
+	}
+}
+
 /**
  * Draw a sprite, not in a viewport
  * @param img  Image number to draw
@@ -981,22 +981,46 @@ static void GenerateTerrain(int type, uint flag)
 
 #include "table/genland.h"
 
-static void CreateDesertOrRainForest(uint desert_tropic_line)
+/**
+ * Mark the tiles that fulfil a condition, checking the tiles in parallel.
+ * The condition may only read the map. Progress is reported four times.
+ * @param condition The condition to check for a tile.
+ * @return For each tile whether it is valid and fulfils the condition.
+ */
+template <typename F>
+static std::vector<uint8_t> FindTilesParallel(F condition)
 {
+	/* Not a std::vector<bool>, as threads may not write to the same byte. */
+	std::vector<uint8_t> result(Map::Size());
 	uint update_freq = Map::Size() / 4;
 
-	for (const auto tile : Map::Iterate()) {
-		if ((tile % update_freq) == 0) IncreaseGeneratingWorldProgress(GWP_LANDSCAPE);
+	for (uint begin = 0; begin < Map::Size(); begin += update_freq) {
+		IncreaseGeneratingWorldProgress(GWP_LANDSCAPE);
+
+		Map::ParallelIterateRange(TileIndex{begin}, TileIndex{begin + update_freq}, [&result, &condition](TileIndex first, TileIndex last) {
+			for (TileIndex tile = first; tile != last; tile++) {
+				result[tile.base()] = IsValidTile(tile) && condition(tile);
+			}
+		});
+	}
 
-		if (!IsValidTile(tile)) continue;
+	return result;
+}
 
+static void CreateDesertOrRainForest(uint desert_tropic_line)
+{
+	/* Deciding which tiles become desert or rainforest only reads the map, so it is done in parallel.
+	 * Setting the tropic zone does not change what the checks read, so the result is the same as
+	 * checking and setting tile by tile. */
+	std::vector<uint8_t> desert = FindTilesParallel([desert_tropic_line](TileIndex tile) {
 		auto allows_desert = [tile, desert_tropic_line](auto &offset) {
 			TileIndex t = AddTileIndexDiffCWrap(tile, offset);
 			return t == INVALID_TILE || (TileHeight(t) < desert_tropic_line && !IsTileType(t, TileType::Water));
 		};
-		if (std::all_of(std::begin(_make_desert_or_rainforest_data), std::end(_make_desert_or_rainforest_data), allows_desert)) {
-			SetTropicZone(tile, TROPICZONE_DESERT);
-		}
+		return std::all_of(std::begin(_make_desert_or_rainforest_data), std::end(_make_desert_or_rainforest_data), allows_desert);
+	});
+	for (const TileIndex tile : Map::Iterate()) {
+		if (desert[tile.base()]) SetTropicZone(tile, TROPICZONE_DESERT);
 	}
 
 	for (uint i = 0; i != TILE_UPDATE_FREQUENCY; i++) {
@@ -1005,18 +1029,15 @@ static void CreateDesertOrRainForest(uint desert_tropic_line)
 		RunTileLoop();
 	}
 
-	for (const auto tile : Map::Iterate()) {
-		if ((tile % update_freq) == 0) IncreaseGeneratingWorldProgress(GWP_LANDSCAPE);
-
-		if (!IsValidTile(tile)) continue;
-
+	std::vector<uint8_t> rainforest = FindTilesParallel([](TileIndex tile) {
 		auto allows_rainforest = [tile](auto &offset) {
 			TileIndex t = AddTileIndexDiffCWrap(tile, offset);
 			return t == INVALID_TILE || !IsTileType(t, TileType::Clear) || !IsClearGround(t, ClearGround::Desert);
 		};
-		if (std::all_of(std::begin(_make_desert_or_rainforest_data), std::end(_make_desert_or_rainforest_data), allows_rainforest)) {
-			SetTropicZone(tile, TROPICZONE_RAINFOREST);
-		}
+		return std::all_of(std::begin(_make_desert_or_rainforest_data), std::end(_make_desert_or_rainforest_data), allows_rainforest);
+	});
+	for (const TileIndex tile : Map::Iterate()) {
+		if (rainforest[tile.base()]) SetTropicZone(tile, TROPICZONE_RAINFOREST);
 	}
 }
 
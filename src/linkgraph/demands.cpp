@@ -10,12 +10,65 @@
 #include "../stdafx.h"
 #include "demands.h"
 #include "../core/math_func.hpp"
+#include "../core/kdtree.hpp"
+#include "../debug.h"
 #include <queue>
 
 #include "../safeguards.h"
 
 typedef std::queue<NodeID> NodeList;
 
+/** Node with demand and its location, for looking up nodes by area. */
+struct DemandNodeXY {
+	NodeID node; ///< ID of the node.
+	uint16_t x; ///< X coordinate of the node's station.
+	uint16_t y; ///< Y coordinate of the node's station.
+
+	bool operator==(const DemandNodeXY &other) const = default;
+};
+
+/** Coordinate accessor for the k-d tree of nodes with demand. */
+struct Kdtree_DemandNodeXYFunc {
+	inline uint16_t operator()(const DemandNodeXY &n, int dim)
+	{
+		return (dim == 0) ? n.x : n.y;
+	}
+};
+
+using DemandNodeKdtree = Kdtree<DemandNodeXY, Kdtree_DemandNodeXYFunc, uint16_t, int>;
+
+/** The demands of a job, to run both the exact and the approximate calculation on the same input. */
+struct DemandState {
+	std::vector<uint> undelivered_supply; ///< Undelivered supply of each node.
+	std::vector<LinkGraphJob::DemandAnnotation> demands; ///< Demands between all pairs of nodes, grouped by source node.
+
+	/**
+	 * Save the demands of a job.
+	 * @param job The job to save the demands of.
+	 */
+	DemandState(LinkGraphJob &job)
+	{
+		for (NodeID node = 0; node < job.Size(); node++) {
+			this->undelivered_supply.push_back(job[node].undelivered_supply);
+			this->demands.insert(this->demands.end(), job[node].demands.begin(), job[node].demands.end());
+		}
+	}
+
+	/**
+	 * Restore the demands of a job.
+	 * @param job The job the demands were saved from.
+	 */
+	void Restore(LinkGraphJob &job) const
+	{
+		auto it = this->demands.begin();
+		for (NodeID node = 0; node < job.Size(); node++) {
+			job[node].undelivered_supply = this->undelivered_supply[node];
+			std::copy_n(it, job[node].demands.size(), job[node].demands.begin());
+			it += job[node].demands.size();
+		}
+	}
+};
+
 /**
  * Scale various things according to symmetric/asymmetric distribution.
  */
@@ -162,6 +215,62 @@ inline void Scaler::SetDemands(LinkGraphJob &job, NodeID from_id, NodeID to_id,
 	job[from_id].DeliverSupply(to_id, demand_forw);
 }
 
+/**
+ * Calculate the demand from one node to another one, based on the effective
+ * supply and the distance between the nodes.
+ * @param from_xy Location of the supplying node.
+ * @param to_xy Location of the receiving node.
+ * @param supply Effective supply from the supplying to the receiving node.
+ * @return Demand in "forward" direction, or 0 if the supply is too small or too far away to be considered.
+ */
+uint DemandCalculator::CalcForwardDemand(TileIndex from_xy, TileIndex to_xy, int32_t supply) const
+{
+	constexpr int32_t divisor_scale = 16;
+
+	int32_t scaled_distance = this->base_distance;
+	if (this->mod_dist > 0) {
+		const int32_t distance = DistanceMaxPlusManhattan(from_xy, to_xy);
+		/* Scale distance around base_distance by (mod_dist * (100 / 1024)).
+		 * mod_dist may be > 1024, so clamp result to be non-negative */
+		scaled_distance = std::max(0, this->base_distance + (((distance - this->base_distance) * this->mod_dist) / 1024));
+	}
+
+	/* Scale the accuracy by distance around accuracy / 2 */
+	const int32_t divisor = divisor_scale + ((this->accuracy * scaled_distance * divisor_scale) / (this->base_distance * 2));
+	assert(divisor >= divisor_scale);
+
+	/* Only distribute demand if effective supply / accuracy divisor >= 1.
+	 * Others are too small or too far away to be considered. */
+	if (divisor > (supply * divisor_scale)) return 0;
+	return (supply * divisor_scale) / divisor;
+}
+
+/**
+ * Get the maximum distance up to which CalcForwardDemand() can return a non-zero demand.
+ * @param supply Effective supply from the supplying node.
+ * @return Maximum distance, or a negative value if there is no such distance.
+ */
+int32_t DemandCalculator::GetDemandRadius(int32_t supply) const
+{
+	constexpr int64_t divisor_scale = 16;
+
+	if (supply <= 0) return -1;
+
+	/* Largest scaled distance for which the divisor stays at most supply * divisor_scale, including
+	 * the part of the scaled accuracy that the integer division in CalcForwardDemand() rounds away. */
+	int64_t max_scaled_distance = ((divisor_scale * (supply - 1) + 1) * this->base_distance * 2 - 1) / (divisor_scale * this->accuracy);
+	if (this->mod_dist == 0) return max_scaled_distance >= this->base_distance ? INT32_MAX : -1;
+
+	/* Invert the scaling of CalcForwardDemand(), which rounds towards zero. */
+	int64_t radius;
+	if (max_scaled_distance >= this->base_distance) {
+		radius = this->base_distance + ((max_scaled_distance - this->base_distance + 1) * 1024 - 1) / this->mod_dist;
+	} else {
+		radius = this->base_distance - ((this->base_distance - max_scaled_distance) * 1024 + this->mod_dist - 1) / this->mod_dist;
+	}
+	return static_cast<int32_t>(Clamp<int64_t>(radius, -1, INT32_MAX));
+}
+
 /**
  * Do the actual demand calculation, called from constructor.
  * @param job Job to calculate the demands for.
@@ -214,27 +323,9 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 			int32_t supply = scaler.EffectiveSupply(job[from_id], job[to_id]);
 			assert(supply > 0);
 
-			constexpr int32_t divisor_scale = 16;
-
-			int32_t scaled_distance = this->base_distance;
-			if (this->mod_dist > 0) {
-				const int32_t distance = DistanceMaxPlusManhattan(job[from_id].base.xy, job[to_id].base.xy);
-				/* Scale distance around base_distance by (mod_dist * (100 / 1024)).
-				 * mod_dist may be > 1024, so clamp result to be non-negative */
-				scaled_distance = std::max(0, this->base_distance + (((distance - this->base_distance) * this->mod_dist) / 1024));
-			}
-
-			/* Scale the accuracy by distance around accuracy / 2 */
-			const int32_t divisor = divisor_scale + ((this->accuracy * scaled_distance * divisor_scale) / (this->base_distance * 2));
-			assert(divisor >= divisor_scale);
-
-			uint demand_forw = 0;
-			if (divisor <= (supply * divisor_scale)) {
-				/* At first only distribute demand if
-				 * effective supply / accuracy divisor >= 1
-				 * Others are too small or too far away to be considered. */
-				demand_forw = (supply * divisor_scale) / divisor;
-			} else if (++chance > this->accuracy * num_demands * num_supplies) {
+			this->pairs_evaluated++;
+			uint demand_forw = this->CalcForwardDemand(job[from_id].base.xy, job[to_id].base.xy, supply);
+			if (demand_forw == 0 && ++chance > this->accuracy * num_demands * num_supplies) {
 				/* After some trying, if there is still supply left, distribute
 				 * demand also to other nodes. */
 				demand_forw = 1;
@@ -261,6 +352,172 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	}
 }
 
+/**
+ * Do an approximate demand calculation which only considers pairs of nodes
+ * that are close enough to each other to get any demand assigned in the
+ * first place. The nodes with demand are looked up in a k-d tree. Supply that
+ * can't be distributed that way is distributed to nodes in an increasing
+ * radius around the supplying node, one unit per pair and round, mirroring the
+ * fallback of the exact calculation. The result only depends on the job, so
+ * it's the same on all clients.
+ * @param job Job to calculate the demands for.
+ * @param scaler Scaler to be used for scaling demands.
+ */
+template <class Tscaler>
+void DemandCalculator::CalcDemandAccelerated(LinkGraphJob &job, Tscaler scaler)
+{
+	std::vector<NodeID> supplies;
+	std::vector<DemandNodeXY> demands;
+	NodeID max_supply_node = INVALID_NODE;
+
+	for (NodeID node = 0; node < job.Size(); node++) {
+		const Node &n = job[node];
+		scaler.AddNode(n);
+		if (n.base.supply > 0) {
+			supplies.push_back(node);
+			if (max_supply_node == INVALID_NODE || n.base.supply > job[max_supply_node].base.supply) max_supply_node = node;
+		}
+		if (n.base.demand > 0) demands.push_back({node, static_cast<uint16_t>(TileX(n.base.xy)), static_cast<uint16_t>(TileY(n.base.xy))});
+	}
+
+	if (supplies.empty() || demands.empty()) return;
+
+	scaler.SetDemandPerNode(static_cast<uint>(demands.size()));
+
+	DemandNodeKdtree tree;
+	tree.Build(demands.begin(), demands.end());
+
+	/* Largest possible distance between two tiles on the map. */
+	const int32_t max_distance = Map::SizeX() + Map::SizeY() + std::max(Map::SizeX(), Map::SizeY());
+	int32_t fallback_radius = 0;
+	std::vector<NodeID> candidates;
+
+	while (!supplies.empty()) {
+		bool delivered = false;
+
+		for (auto it = supplies.begin(); it != supplies.end();) {
+			NodeID from_id = *it;
+			const Node &from = job[from_id];
+
+			/* The node with the largest supply gets the largest effective supply in symmetric mode. */
+			int32_t radius = this->GetDemandRadius(scaler.EffectiveSupply(from, job[max_supply_node]));
+			radius = std::min(std::max(radius, fallback_radius), max_distance);
+
+			candidates.clear();
+			if (radius >= 0) {
+				/* DistanceMaxPlusManhattan is at least twice the larger of the axis distances. */
+				int32_t half = radius / 2;
+				int32_t x = TileX(from.base.xy);
+				int32_t y = TileY(from.base.xy);
+				tree.FindContained(
+						static_cast<uint16_t>(std::max(0, x - half)), static_cast<uint16_t>(std::max(0, y - half)),
+						static_cast<uint16_t>(std::min<int32_t>(x + half + 1, Map::SizeX())), static_cast<uint16_t>(std::min<int32_t>(y + half + 1, Map::SizeY())),
+						[&candidates](const DemandNodeXY &n) { candidates.push_back(n.node); });
+				/* Visit candidates in a defined order, independent of the shape of the tree. */
+				std::sort(candidates.begin(), candidates.end());
+			}
+
+			for (NodeID to_id : candidates) {
+				if (to_id == from_id) continue;
+				const Node &to = job[to_id];
+				if (!scaler.HasDemandLeft(to)) continue;
+				if (static_cast<int32_t>(DistanceMaxPlusManhattan(from.base.xy, to.base.xy)) > radius) continue;
+
+				int32_t supply = scaler.EffectiveSupply(from, to);
+				assert(supply > 0);
+
+				this->pairs_evaluated++;
+				uint demand_forw = this->CalcForwardDemand(from.base.xy, to.base.xy, supply);
+				if (demand_forw == 0 && fallback_radius > 0) demand_forw = 1;
+				demand_forw = std::min(demand_forw, from.undelivered_supply);
+				if (demand_forw == 0) continue;
+
+				scaler.SetDemands(job, from_id, to_id, demand_forw);
+				delivered = true;
+
+				if (from.undelivered_supply == 0) break;
+			}
+
+			if (from.undelivered_supply == 0) {
+				it = supplies.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		if (!delivered) {
+			/* Nothing could be delivered anywhere on the map, so there is no demand left. */
+			if (fallback_radius >= max_distance) break;
+			/* Widen the search for nodes that get their supply in the fallback mode. */
+			fallback_radius = std::max(fallback_radius * 2, 16);
+		}
+	}
+}
+
+/**
+ * Report how the demands of the approximate calculation differ from those of the exact calculation.
+ * @param job Job with the demands of the approximate calculation.
+ * @param exact Demands of the exact calculation.
+ * @param exact_pairs Number of node pairs evaluated by the exact calculation.
+ */
+void DemandCalculator::ReportDifferences(LinkGraphJob &job, const DemandState &exact, uint64_t exact_pairs) const
+{
+	uint64_t total_exact = 0;
+	uint64_t total_approximate = 0;
+	uint64_t total_difference = 0;
+	uint pairs_different = 0;
+
+	auto it = exact.demands.begin();
+	for (NodeID from = 0; from < job.Size(); from++) {
+		for (NodeID to = 0; to < job.Size(); to++, ++it) {
+			uint demand_exact = it->demand;
+			uint demand_approximate = job[from].DemandTo(to);
+			total_exact += demand_exact;
+			total_approximate += demand_approximate;
+			if (demand_exact == demand_approximate) continue;
+
+			pairs_different++;
+			total_difference += Delta(demand_exact, demand_approximate);
+			Debug(misc, 5, "Demand of link graph {} from station {} to station {}: {} exact, {} approximately",
+					job.LinkGraphIndex(), job[from].base.station, job[to].base.station, demand_exact, demand_approximate);
+		}
+	}
+
+	Debug(misc, 4, "Demands of link graph {} calculated approximately differ for {} of {} node pairs by {} in total; total demand {} exact, {} approximately; {} node pairs evaluated exactly, {} approximately",
+			job.LinkGraphIndex(), pairs_different, job.Size() * job.Size(), total_difference, total_exact, total_approximate, exact_pairs, this->pairs_evaluated);
+}
+
+/**
+ * Do the demand calculation in the requested mode. With the approximate mode
+ * and a debug level of misc of 4 or more the exact calculation is done as
+ * well, to report how the approximate demands differ from the exact ones.
+ * @param job Job to calculate the demands for.
+ * @param scaler Scaler to be used for scaling demands.
+ * @param accelerated Whether to do the approximate calculation.
+ */
+template <class Tscaler>
+void DemandCalculator::CalcDemandInMode(LinkGraphJob &job, Tscaler scaler, bool accelerated)
+{
+	if (!accelerated) {
+		this->CalcDemand<Tscaler>(job, scaler);
+		return;
+	}
+	if (_debug_misc_level < 4) {
+		this->CalcDemandAccelerated<Tscaler>(job, scaler);
+		return;
+	}
+
+	DemandState input(job);
+	this->CalcDemand<Tscaler>(job, scaler);
+	DemandState exact(job);
+	uint64_t exact_pairs = this->pairs_evaluated;
+
+	input.Restore(job);
+	this->pairs_evaluated = 0;
+	this->CalcDemandAccelerated<Tscaler>(job, scaler);
+	this->ReportDifferences(job, exact, exact_pairs);
+}
+
 /**
  * Create the DemandCalculator and immediately do the calculation.
  * @param job Job to calculate the demands for.
@@ -287,13 +544,16 @@ DemandCalculator::DemandCalculator(LinkGraphJob &job) :
 
 	switch (settings.GetDistributionType(cargo)) {
 		case DistributionType::Symmetric:
-			this->CalcDemand<SymmetricScaler>(job, SymmetricScaler(settings.demand_size));
+			this->CalcDemandInMode<SymmetricScaler>(job, SymmetricScaler(settings.demand_size), settings.demand_accelerated);
 			break;
 		case DistributionType::Asymmetric:
-			this->CalcDemand<AsymmetricScaler>(job, AsymmetricScaler());
+			this->CalcDemandInMode<AsymmetricScaler>(job, AsymmetricScaler(), settings.demand_accelerated);
 			break;
 		default:
 			/* Nothing to do. */
-			break;
+			return;
 	}
+
+	Debug(misc, 3, "Demands of link graph {} ({} nodes) calculated {}: {} node pairs evaluated",
+			job.LinkGraphIndex(), job.Size(), settings.demand_accelerated ? "approximately" : "exactly", this->pairs_evaluated);
 }
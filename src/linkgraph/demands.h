@@ -12,6 +12,8 @@
 
 #include "linkgraphjob_base.h"
 
+struct DemandState;
+
 /**
  * Calculate the demands. This class has a state, but is recreated for each
  * call to of DemandHandler::Run.
@@ -24,9 +26,21 @@ private:
 	int32_t base_distance; ///< Base distance for scaling purposes.
 	int32_t mod_dist;      ///< Distance modifier, determines how much demands decrease with distance.
 	int32_t accuracy;      ///< Accuracy of the calculation.
+	uint64_t pairs_evaluated = 0; ///< Number of pairs of nodes the demand was calculated for.
+
+	uint CalcForwardDemand(TileIndex from_xy, TileIndex to_xy, int32_t supply) const;
+	int32_t GetDemandRadius(int32_t supply) const;
 
 	template <class Tscaler>
 	void CalcDemand(LinkGraphJob &job, Tscaler scaler);
+
+	template <class Tscaler>
+	void CalcDemandAccelerated(LinkGraphJob &job, Tscaler scaler);
+
+	template <class Tscaler>
+	void CalcDemandInMode(LinkGraphJob &job, Tscaler scaler, bool accelerated);
+
+	void ReportDifferences(LinkGraphJob &job, const DemandState &exact, uint64_t exact_pairs) const;
 };
 
 /**
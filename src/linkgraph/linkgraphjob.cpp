@@ -38,9 +38,45 @@ LinkGraphJob::LinkGraphJob(LinkGraphJobID index, const LinkGraph &orig) :
 		/* Copying the link graph here also copies its index member.
 		 * This is on purpose. */
 		link_graph(orig),
-		settings(_settings_game.linkgraph),
-		join_date(TimerGameEconomy::date + (_settings_game.linkgraph.recalc_time / EconomyTime::SECONDS_PER_DAY))
+		settings(_settings_game.linkgraph)
 {
+	this->join_date = TimerGameEconomy::date + this->Duration();
+}
+
+/**
+ * Estimate the computational cost of running a job on a link graph. The MCF
+ * passes dominate the run time; they run a Dijkstra search from every node,
+ * each of which visits every node and edge. The estimate only depends on the
+ * link graph itself, so that all clients in a network game agree on it.
+ * @param lg Link graph to estimate the cost for.
+ * @return Cost in arbitrary units.
+ */
+/* static */ uint64_t LinkGraphJob::EstimateCost(const LinkGraph &lg)
+{
+	uint64_t edges = 0;
+	for (NodeID node_id = 0; node_id < lg.Size(); ++node_id) edges += lg[node_id].edges.size();
+	return static_cast<uint64_t>(lg.Size()) * (lg.Size() + edges);
+}
+
+/**
+ * Get the number of days between spawning and joining this job. Normally
+ * this is the configured recalculation time. With adaptive recalculation
+ * time it is scaled by the estimated cost of the job, so small link graphs
+ * are joined early and large ones get more time to finish in the background.
+ * @return Duration of the job in days.
+ */
+int LinkGraphJob::Duration() const
+{
+	int base = this->settings.recalc_time / EconomyTime::SECONDS_PER_DAY;
+	if (!this->settings.adaptive_recalc_time) return base;
+
+	/* A recalculation time below one day still takes a day to join; also scale from there. */
+	base = std::max(1, base);
+
+	/* Cost of a link graph which gets exactly the configured recalculation time. */
+	static const uint64_t REFERENCE_COST = 1 << 16;
+	uint64_t scaled = base * LinkGraphJob::EstimateCost(this->link_graph) / REFERENCE_COST;
+	return static_cast<int>(Clamp<uint64_t>(scaled, std::max(1, base / 4), base * 4));
 }
 
 /**
@@ -126,7 +162,7 @@ LinkGraphJob::~LinkGraphJob()
 
 		for (const auto &edge : from.edges) {
 			if (edge.Flow() == 0) continue;
-			NodeID dest_id = edge.base.dest_node;
+			NodeID dest_id = edge.dest_node;
 			StationID to = this->nodes[dest_id].base.station;
 			Station *st2 = Station::GetIfValid(to);
 			if (st2 == nullptr || st2->goods[this->Cargo()].link_graph != this->link_graph.index ||
@@ -178,15 +214,33 @@ LinkGraphJob::~LinkGraphJob()
 
 /**
  * Initialize the link graph job: Resize nodes and edges and populate them.
+ * The edges of all nodes are stored in a single array, where the edges of
+ * each node form one contiguous range. Demands are stored likewise.
  * This is done after the constructor so that we can do it in the calculation
  * thread without delaying the main game.
  */
 void LinkGraphJob::Init()
 {
 	uint size = this->Size();
+
+	size_t num_edges = 0;
+	for (uint i = 0; i < size; ++i) {
+		num_edges += this->link_graph.nodes[i].edges.size();
+	}
+
+	/* The nodes keep spans into these, so they must not be reallocated later on. */
+	this->edges.reserve(num_edges);
+	this->demands.resize(static_cast<size_t>(size) * size);
+
 	this->nodes.reserve(size);
 	for (uint i = 0; i < size; ++i) {
-		this->nodes.emplace_back(this->link_graph.nodes[i], this->link_graph.Size());
+		const LinkGraph::BaseNode &node = this->link_graph.nodes[i];
+		size_t first = this->edges.size();
+		for (const LinkGraph::BaseEdge &edge : node.edges) {
+			uint distance = DistanceMaxPlusManhattan(node.xy, this->link_graph.nodes[edge.dest_node].xy) + 1;
+			this->edges.emplace_back(edge, distance);
+		}
+		this->nodes.emplace_back(node, std::span(this->edges).subspan(first), std::span(this->demands).subspan(static_cast<size_t>(i) * size, size));
 	}
 }
 
@@ -225,7 +279,7 @@ uint Path::AddFlow(uint new_flow, LinkGraphJob &job, uint max_saturation)
 	if (this->parent != nullptr) {
 		LinkGraphJob::EdgeAnnotation &edge = job[this->parent->node][this->node];
 		if (max_saturation != UINT_MAX) {
-			uint usable_cap = edge.base.capacity * max_saturation / 100;
+			uint usable_cap = edge.capacity * max_saturation / 100;
 			if (usable_cap > edge.Flow()) {
 				new_flow = std::min(new_flow, usable_cap - edge.Flow());
 			} else {
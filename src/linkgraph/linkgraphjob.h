@@ -13,6 +13,7 @@
 #include "../thread.h"
 #include "linkgraph.h"
 #include <atomic>
+#include <chrono>
 
 class LinkGraphJob;
 class Path;
@@ -37,13 +38,19 @@ public:
 	};
 
 	/**
-	 * Annotation for a link graph edge.
+	 * Annotation for a link graph edge. The relevant data of the underlying
+	 * edge is copied so that all edges of a job can be stored contiguously.
 	 */
 	struct EdgeAnnotation {
-		const LinkGraph::BaseEdge &base; ///< Reference to the edge that is annotated.
+		NodeID dest_node = INVALID_NODE; ///< Destination of the edge.
+		uint capacity = 0; ///< Capacity of the edge.
+		uint distance = 0; ///< Distance between the ends of the edge, plus one tile penalty for the stop.
+		uint travel_time = 0; ///< Average travel time over the edge, in ticks, or 0 if unknown.
 		uint flow = 0; ///< Planned flow over this edge.
 
-		EdgeAnnotation(const LinkGraph::BaseEdge &base) : base(base) {}
+		EdgeAnnotation(const LinkGraph::BaseEdge &base, uint distance) :
+				dest_node(base.dest_node), capacity(base.capacity), distance(distance),
+				travel_time(base.capacity == 0 ? 0 : base.TravelTime()) {}
 
 		/**
 		 * Get the total flow on the edge.
@@ -66,11 +73,6 @@ public:
 			assert(flow <= this->flow);
 			this->flow -= flow;
 		}
-
-		friend inline bool operator <(NodeID dest, const EdgeAnnotation &rhs)
-		{
-			return dest < rhs.base.dest_node;
-		}
 	};
 
 	/**
@@ -83,15 +85,11 @@ public:
 		PathList paths{}; ///< Paths through this node, sorted so that those with flow == 0 are in the back.
 		FlowStatMap flows{}; ///< Planned flows to other nodes.
 
-		std::vector<EdgeAnnotation> edges{}; ///< Annotations for all edges originating at this node.
-		std::vector<DemandAnnotation> demands{}; ///< Annotations for the demand to all other nodes.
+		std::span<EdgeAnnotation> edges{}; ///< Annotations for all edges originating at this node, sorted by destination.
+		std::span<DemandAnnotation> demands{}; ///< Annotations for the demand to all other nodes.
 
-		NodeAnnotation(const LinkGraph::BaseNode &node, size_t size) : base(node), undelivered_supply(node.supply)
-		{
-			this->edges.reserve(node.edges.size());
-			for (auto &e : node.edges) this->edges.emplace_back(e);
-			this->demands.resize(size);
-		}
+		NodeAnnotation(const LinkGraph::BaseNode &node, std::span<EdgeAnnotation> edges, std::span<DemandAnnotation> demands) :
+				base(node), undelivered_supply(node.supply), edges(edges), demands(demands) {}
 
 		/**
 		 * Retrieve an edge starting at this node.
@@ -100,8 +98,8 @@ public:
 		 */
 		EdgeAnnotation &operator[](NodeID to)
 		{
-			auto it = std::ranges::find_if(this->edges, [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::ranges::lower_bound(this->edges, to, std::less{}, &EdgeAnnotation::dest_node);
+			assert(it != this->edges.end() && it->dest_node == to);
 			return *it;
 		}
 
@@ -112,8 +110,8 @@ public:
 		 */
 		const EdgeAnnotation &operator[](NodeID to) const
 		{
-			auto it = std::ranges::find_if(this->edges, [=] (const EdgeAnnotation &e) { return e.base.dest_node == to; });
-			assert(it != this->edges.end());
+			auto it = std::ranges::lower_bound(this->edges, to, std::less{}, &EdgeAnnotation::dest_node);
+			assert(it != this->edges.end() && it->dest_node == to);
 			return *it;
 		}
 
@@ -167,8 +165,11 @@ protected:
 	std::thread thread{}; ///< Thread the job is running in or a default-constructed thread if it's running in the main thread.
 	TimerGameEconomy::Date join_date = EconomyTime::INVALID_DATE; ///< Date when the job is to be joined.
 	NodeAnnotationVector nodes{}; ///< Extra node data necessary for link graph calculation.
+	std::vector<EdgeAnnotation> edges{}; ///< Edge annotations of all nodes, grouped by source node (compressed sparse row layout).
+	std::vector<DemandAnnotation> demands{}; ///< Demand annotations of all pairs of nodes, grouped by source node.
 	std::atomic<bool> job_completed = false; ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
 	std::atomic<bool> job_aborted = false; ///< Has the job been aborted. This is accessed by multiple threads and reads may be stale.
+	std::chrono::steady_clock::duration run_time{}; ///< Wall clock time the handlers took. Only valid after the thread has been joined, never used for game decisions.
 
 	void EraseFlows(StationID from);
 	void JoinThread();
@@ -187,6 +188,21 @@ public:
 
 	void Init();
 
+	static uint64_t EstimateCost(const LinkGraph &lg);
+	int Duration() const;
+
+	/**
+	 * Get the estimated computational cost of this job.
+	 * @return Cost in arbitrary units, only depending on the size of the link graph.
+	 */
+	inline uint64_t Cost() const { return LinkGraphJob::EstimateCost(this->link_graph); }
+
+	/**
+	 * Get the wall clock time the handlers of this job took. Only valid after the job has been joined.
+	 * @return Run time of the job.
+	 */
+	inline std::chrono::steady_clock::duration RunTime() const { return this->run_time; }
+
 	/**
 	 * Check if job has actually finished.
 	 * This is allowed to spuriously return an incorrect value.
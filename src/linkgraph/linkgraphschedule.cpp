@@ -45,7 +45,10 @@ void LinkGraphSchedule::SpawnNext()
 	if (LinkGraphJob::CanAllocateItem()) {
 		LinkGraphJob *job = LinkGraphJob::Create(*next);
 		job->SpawnThread();
-		this->running.push_back(job);
+		/* Jobs can have different durations, keep the running list ordered by
+		 * join date so that the front is always the next one to be joined. */
+		auto it = std::ranges::upper_bound(this->running, job->JoinDate(), std::less{}, &LinkGraphJob::JoinDate);
+		this->running.insert(it, job);
 	} else {
 		NOT_REACHED();
 	}
@@ -57,27 +60,54 @@ void LinkGraphSchedule::SpawnNext()
  */
 bool LinkGraphSchedule::IsJoinWithUnfinishedJobDue() const
 {
-	if (this->running.empty()) return false;
-	const LinkGraphJob *next = this->running.front();
-	return next->IsScheduledToBeJoined() && !next->IsJobCompleted();
+	for (const LinkGraphJob *job : this->running) {
+		if (!job->IsScheduledToBeJoined()) return false;
+		if (!job->IsJobCompleted()) return true;
+	}
+	return false;
 }
 
 /**
- * Join the next finished job, if available.
+ * Join all jobs which are due, if available.
  */
 void LinkGraphSchedule::JoinNext()
 {
-	if (this->running.empty()) return;
-	LinkGraphJob *next = this->running.front();
-	if (!next->IsScheduledToBeJoined()) return;
-	this->running.pop_front();
-	LinkGraphID id = next->LinkGraphIndex();
-	delete next; // implicitly joins the thread
-	if (LinkGraph::IsValidID(id)) {
-		LinkGraph *lg = LinkGraph::Get(id);
-		this->Dequeue(lg); // Dequeue to avoid double-queueing recycled IDs.
-		this->Queue(lg);
+	while (!this->running.empty()) {
+		LinkGraphJob *next = this->running.front();
+		if (!next->IsScheduledToBeJoined()) return;
+		this->running.pop_front();
+		LinkGraphID id = next->LinkGraphIndex();
+		next->JoinThread();
+
+		if (this->history.size() == MAX_HISTORY) this->history.pop_front();
+		this->history.emplace_back(id, next->Cargo(), next->Size(), next->Cost(), next->Duration(),
+				std::chrono::duration_cast<std::chrono::microseconds>(next->RunTime()));
+
+		delete next;
+		if (LinkGraph::IsValidID(id)) {
+			LinkGraph *lg = LinkGraph::Get(id);
+			this->Dequeue(lg); // Dequeue to avoid double-queueing recycled IDs.
+			this->Queue(lg);
+		}
+	}
+}
+
+/**
+ * Get the average wall clock time per unit of estimated cost of the recently
+ * finished jobs. This can be used to predict the run time of a job on this
+ * machine, but must never influence the game state.
+ * @return Microseconds per unit of cost, or 0 if no jobs have finished yet.
+ */
+double LinkGraphSchedule::GetMicrosecondsPerCost() const
+{
+	uint64_t cost = 0;
+	std::chrono::microseconds run_time{};
+	for (const JobRecord &record : this->history) {
+		cost += record.cost;
+		run_time += record.run_time;
 	}
+	if (cost == 0) return 0;
+	return static_cast<double>(run_time.count()) / cost;
 }
 
 /**
@@ -86,10 +116,12 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
+	auto start = std::chrono::steady_clock::now();
 	for (const auto &handler : instance.handlers) {
 		if (job->IsJobAborted()) return;
 		handler->Run(*job);
 	}
+	job->run_time = std::chrono::steady_clock::now() - start;
 
 	/*
 	 * Readers of this variable in another thread may see an out of date value.
@@ -125,6 +157,7 @@ void LinkGraphSchedule::SpawnAll()
 	}
 	instance.running.clear();
 	instance.schedule.clear();
+	instance.history.clear();
 }
 
 /**
@@ -11,6 +11,8 @@
 #define LINKGRAPHSCHEDULE_H
 
 #include "linkgraph.h"
+#include <chrono>
+#include <deque>
 
 class LinkGraphJob;
 
@@ -32,6 +34,19 @@ public:
 };
 
 class LinkGraphSchedule {
+public:
+	/** Statistics about a finished job, for reporting only. */
+	struct JobRecord {
+		LinkGraphID link_graph; ///< Link graph the job was run on.
+		CargoType cargo; ///< Cargo of the link graph.
+		NodeID nodes; ///< Number of nodes in the link graph.
+		uint64_t cost; ///< Estimated cost of the job.
+		int duration; ///< Days between spawning and joining the job.
+		std::chrono::microseconds run_time; ///< Wall clock time the job actually took.
+	};
+
+	static const size_t MAX_HISTORY = 32; ///< Number of finished jobs to keep statistics for.
+
 private:
 	LinkGraphSchedule();
 	~LinkGraphSchedule();
@@ -42,7 +57,8 @@ private:
 protected:
 	std::array<std::unique_ptr<ComponentHandler>, 6> handlers{}; ///< Handlers to be run for each job.
 	GraphList schedule;            ///< Queue for new jobs.
-	JobList running;               ///< Currently running jobs.
+	JobList running;               ///< Currently running jobs, ordered by join date.
+	std::deque<JobRecord> history; ///< Statistics of recently finished jobs; not saved.
 
 public:
 	/* This is a tick where not much else is happening, so a small lag might go unnoticed. */
@@ -57,6 +73,25 @@ public:
 	void JoinNext();
 	void SpawnAll();
 	void ShiftDates(TimerGameEconomy::Date interval);
+	double GetMicrosecondsPerCost() const;
+
+	/**
+	 * Get the currently running jobs.
+	 * @return Running jobs, ordered by join date.
+	 */
+	const JobList &GetRunning() const { return this->running; }
+
+	/**
+	 * Get the number of link graphs waiting for a job to be spawned.
+	 * @return Number of queued link graphs.
+	 */
+	size_t GetScheduledCount() const { return this->schedule.size(); }
+
+	/**
+	 * Get statistics about the recently finished jobs.
+	 * @return Finished jobs, oldest first.
+	 */
+	const std::deque<JobRecord> &GetHistory() const { return this->history; }
 
 	/**
 	 * Queue a link graph for execution.
@@ -102,8 +102,8 @@ class GraphEdgeIterator {
 private:
 	LinkGraphJob &job; ///< Job being executed
 
-	std::vector<LinkGraphJob::EdgeAnnotation>::const_iterator i;   ///< Iterator pointing to current edge.
-	std::vector<LinkGraphJob::EdgeAnnotation>::const_iterator end; ///< Iterator pointing beyond last edge.
+	std::span<LinkGraphJob::EdgeAnnotation>::iterator i;   ///< Iterator pointing to current edge.
+	std::span<LinkGraphJob::EdgeAnnotation>::iterator end; ///< Iterator pointing beyond last edge.
 
 public:
 
@@ -119,8 +119,8 @@ public:
 	 */
 	void SetNode(NodeID, NodeID node)
 	{
-		this->i = this->job[node].edges.cbegin();
-		this->end = this->job[node].edges.cend();
+		this->i = this->job[node].edges.begin();
+		this->end = this->job[node].edges.end();
 	}
 
 	/**
@@ -129,7 +129,7 @@ public:
 	 */
 	NodeID Next()
 	{
-		return this->i != this->end ? (this->i++)->base.dest_node : INVALID_NODE;
+		return this->i != this->end ? (this->i++)->dest_node : INVALID_NODE;
 	}
 };
 
@@ -284,7 +284,7 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 		for (NodeID to = iter.Next(); to != INVALID_NODE; to = iter.Next()) {
 			if (to == from) continue; // Not a real edge but a consumption sign.
 			const Edge &edge = this->job[from][to];
-			uint capacity = edge.base.capacity;
+			uint capacity = edge.capacity;
 			if (this->max_saturation != UINT_MAX) {
 				capacity *= this->max_saturation;
 				capacity /= 100;
@@ -296,10 +296,9 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 			bool express = IsCargoInClass(this->job.Cargo(), CargoClass::Passengers) ||
 				IsCargoInClass(this->job.Cargo(), CargoClass::Mail) ||
 				IsCargoInClass(this->job.Cargo(), CargoClass::Express);
-			uint distance = DistanceMaxPlusManhattan(this->job[from].base.xy, this->job[to].base.xy) + 1;
 			/* Compute a default travel time from the distance and an average speed of 1 tile/day. */
-			uint time = (edge.base.TravelTime() != 0) ? edge.base.TravelTime() + Ticks::DAY_TICKS : distance * Ticks::DAY_TICKS;
-			uint distance_anno = express ? time : distance;
+			uint time = (edge.travel_time != 0) ? edge.travel_time + Ticks::DAY_TICKS : edge.distance * Ticks::DAY_TICKS;
+			uint distance_anno = express ? time : edge.distance;
 
 			Tannotation *dest = static_cast<Tannotation *>(paths[to]);
 			if (dest->IsBetter(source, capacity, capacity - edge.Flow(), distance_anno)) {
@@ -19,6 +19,10 @@
 
 /**
  * Refresh all links the given vehicle will visit.
+ * If the order list doesn't contain refit orders, the links only depend on the
+ * orders, the order the vehicle starts at and whether it has cargo, so they
+ * are cached in the order list and reused for all vehicles sharing it until
+ * the orders change.
  * @param v Vehicle to refresh links for.
  * @param allow_merge If the refresher is allowed to merge or extend link graphs.
  * @param is_full_loading If the vehicle is full loading.
@@ -27,15 +31,30 @@
 {
 	/* If there are no orders we can't predict anything.*/
 	if (v->orders == nullptr) return;
+	OrderList &orderlist = *v->orders;
 
 	/* Make sure the first order is a useful order. */
-	VehicleOrderID first = v->orders->GetNextDecisionNode(v->cur_implicit_order_index, 0);
+	VehicleOrderID first = orderlist.GetNextDecisionNode(v->cur_implicit_order_index, 0);
 	if (first == INVALID_VEH_ORDER_ID) return;
 
+	bool has_cargo = v->last_loading_station != StationID::Invalid();
+
+	auto cached = orderlist.link_predictions.find({first, has_cargo});
+	if (cached != orderlist.link_predictions.end()) {
+		LinkRefresher refresher(v, nullptr, nullptr, allow_merge, is_full_loading);
+		for (const auto &[cur, next] : cached->second) {
+			refresher.RefreshStats(cur, next);
+		}
+		return;
+	}
+
 	HopSet seen_hops;
-	LinkRefresher refresher(v, &seen_hops, allow_merge, is_full_loading);
+	Prediction prediction;
+	LinkRefresher refresher(v, &seen_hops, &prediction, allow_merge, is_full_loading);
+
+	refresher.RefreshLinks(first, first, has_cargo ? RefreshFlags{RefreshFlag::HasCargo} : RefreshFlags{});
 
-	refresher.RefreshLinks(first, first, v->last_loading_station != StationID::Invalid() ? RefreshFlags{RefreshFlag::HasCargo} : RefreshFlags{});
+	if (prediction.cacheable) orderlist.link_predictions.emplace(std::make_pair(first, has_cargo), std::move(prediction.links));
 }
 
 /**
@@ -43,11 +62,13 @@
  * @param vehicle Vehicle to refresh links for.
  * @param seen_hops Set of hops already seen. This is shared between this
  *                  refresher and all its children.
+ * @param prediction Links found during this run. This is shared between this
+ *                   refresher and all its children.
  * @param allow_merge If the refresher is allowed to merge or extend link graphs.
  * @param is_full_loading If the vehicle is full loading.
  */
-LinkRefresher::LinkRefresher(Vehicle *vehicle, HopSet *seen_hops, bool allow_merge, bool is_full_loading) :
-	vehicle(vehicle), seen_hops(seen_hops), cargo(INVALID_CARGO), allow_merge(allow_merge),
+LinkRefresher::LinkRefresher(Vehicle *vehicle, HopSet *seen_hops, Prediction *prediction, bool allow_merge, bool is_full_loading) :
+	vehicle(vehicle), seen_hops(seen_hops), prediction(prediction), cargo(INVALID_CARGO), allow_merge(allow_merge),
 	is_full_loading(is_full_loading)
 {
 	/* Assemble list of capacities and set last loading stations to 0. */
@@ -254,6 +275,8 @@ void LinkRefresher::RefreshLinks(VehicleOrderID cur, VehicleOrderID next, Refres
 		const Order *next_order = orderlist.GetOrderAt(next);
 
 		if ((next_order->IsType(OT_GOTO_DEPOT) || next_order->IsType(OT_GOTO_STATION)) && next_order->IsRefit()) {
+			/* Refits depend on the consist, so the links can't be reused for other vehicles. */
+			this->prediction->cacheable = false;
 			flags.Set(RefreshFlag::WasRefit);
 			if (!next_order->IsAutoRefit()) {
 				this->HandleRefit(next_order->GetRefitCargo());
@@ -305,6 +328,7 @@ void LinkRefresher::RefreshLinks(VehicleOrderID cur, VehicleOrderID next, Refres
 		if (cur_order->IsType(OT_GOTO_STATION) || cur_order->IsType(OT_IMPLICIT)) {
 			if (cur_order->CanLeaveWithCargo(flags.Test(RefreshFlag::HasCargo))) {
 				flags.Set(RefreshFlag::HasCargo);
+				this->prediction->links.emplace_back(cur, next);
 				this->RefreshStats(cur, next);
 			} else {
 				flags.Reset(RefreshFlag::HasCargo);
@@ -80,15 +80,25 @@ protected:
 	typedef std::vector<RefitDesc> RefitList;
 	typedef std::set<Hop> HopSet;
 
+	/**
+	 * Links found while walking the order list. This is shared between all
+	 * Refreshers of the same run.
+	 */
+	struct Prediction {
+		std::vector<std::pair<VehicleOrderID, VehicleOrderID>> links; ///< Pairs of orders that had their links refreshed, in order.
+		bool cacheable = true; ///< If the links don't depend on the consist, i.e. no refit orders were evaluated.
+	};
+
 	Vehicle *vehicle;           ///< Vehicle for which the links should be refreshed.
 	CargoArray capacities{}; ///< Current added capacities per cargo type in the consist.
 	RefitList refit_capacities; ///< Current state of capacity remaining from previous refits versus overall capacity per vehicle in the consist.
 	HopSet *seen_hops;          ///< Hops already seen. If the same hop is seen twice we stop the algorithm. This is shared between all Refreshers of the same run.
+	Prediction *prediction;     ///< Links found so far. This is shared between all Refreshers of the same run.
 	CargoType cargo;              ///< Cargo given in last refit order.
 	bool allow_merge;           ///< If the refresher is allowed to merge or extend link graphs.
 	bool is_full_loading;       ///< If the vehicle is full loading.
 
-	LinkRefresher(Vehicle *v, HopSet *seen_hops, bool allow_merge, bool is_full_loading);
+	LinkRefresher(Vehicle *v, HopSet *seen_hops, Prediction *prediction, bool allow_merge, bool is_full_loading);
 
 	bool HandleRefit(CargoType refit_cargo);
 	void ResetRefit();
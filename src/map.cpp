@@ -13,6 +13,7 @@
 #include "error_func.h"
 #include "string_func.h"
 #include "pathfinder/water_regions.h"
+#include "thread.h"
 
 #include "safeguards.h"
 
@@ -74,6 +75,48 @@
 	Map::initial_land_count = std::min(Map::initial_land_count, Map::size);
 }
 
+/**
+ * Call a function for consecutive ranges of tiles, spread over multiple threads.
+ * The calling thread processes ranges as well, and this function only returns
+ * once all tiles in the range have been processed. Small ranges are processed
+ * by the calling thread alone, as starting threads would cost more than it gains.
+ * @param begin The first tile to process.
+ * @param end The tile after the last tile to process.
+ * @param proc The function to call for each range of tiles; see Map::ParallelIterate for what it may do.
+ */
+/* static */ void Map::ParallelIterateRange(TileIndex begin, TileIndex end, const std::function<void(TileIndex begin, TileIndex end)> &proc)
+{
+	/* Enough tiles per range to keep the threads busy for a while, and to not share cache lines between them. */
+	static const uint TILES_PER_RANGE = 1U << 16;
+
+	uint num_ranges = CeilDiv(end.base() - begin.base(), TILES_PER_RANGE);
+	uint num_threads = std::min(std::max(std::thread::hardware_concurrency(), 1U), num_ranges) - 1;
+	if (num_threads == 0) {
+		if (begin != end) proc(begin, end);
+		return;
+	}
+
+	std::atomic<uint> next_range = 0;
+	auto process_ranges = [&]() {
+		for (uint i = next_range++; i < num_ranges; i = next_range++) {
+			TileIndex range_begin = begin + i * TILES_PER_RANGE;
+			proc(range_begin, TileIndex{std::min(range_begin.base() + TILES_PER_RANGE, end.base())});
+		}
+	};
+
+	std::vector<std::thread> threads(num_threads);
+	for (std::thread &thread : threads) {
+		if (!StartNewThread(&thread, "ottd:maptiles", [&process_ranges]() { process_ranges(); })) break;
+	}
+
+	/* Do our share, or everything when no thread could be started. */
+	process_ranges();
+
+	for (std::thread &thread : threads) {
+		if (thread.joinable()) thread.join();
+	}
+}
+
 /**
  * Get a tile from the virtual XY-coordinate.
  * Coordinates outside of the map are clamped to the map edge.
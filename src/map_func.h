@@ -364,6 +364,24 @@ public:
 	 * @return an iterable ensemble of all Tiles
 	 */
 	static IterateWrapper Iterate() { return IterateWrapper(); }
+
+	static void ParallelIterateRange(TileIndex begin, TileIndex end, const std::function<void(TileIndex begin, TileIndex end)> &proc);
+
+	/**
+	 * Call a function for every Tile of the map, spread over multiple threads.
+	 * The order in which the tiles are visited is undefined. So the function
+	 * may only modify the tile it is called for, may only read other tiles
+	 * when nothing modifies those, and must not touch any other game state,
+	 * such as the pools or the random number generator.
+	 * @param proc The function to call for every Tile.
+	 */
+	template <typename F>
+	static void ParallelIterate(F proc)
+	{
+		Map::ParallelIterateRange(TileIndex{}, TileIndex{Map::Size()}, [&proc](TileIndex begin, TileIndex end) {
+			for (TileIndex t = begin; t != end; t++) proc(Tile(t));
+		});
+	}
 };
 
 /**
@@ -12,8 +12,110 @@
 
 #include "packet.h"
 
+#include <atomic>
+
 #include "../../safeguards.h"
 
+static std::atomic<uint64_t> _packet_buffers_allocated; ///< Number of packet buffers that had to be allocated.
+static std::atomic<uint64_t> _packet_buffers_reused; ///< Number of packet buffers that were taken from the pool.
+static std::atomic<uint64_t> _packets_sent; ///< Number of TCP packets that have been sent completely.
+static std::atomic<uint64_t> _packet_send_calls; ///< Number of calls to the operating system to send TCP packets.
+
+/**
+ * Get the counters of the work done for transferring packets since the start.
+ * @return The counters.
+ */
+PacketCounters GetPacketCounters()
+{
+	return {_packet_buffers_allocated.load(std::memory_order_relaxed), _packet_buffers_reused.load(std::memory_order_relaxed),
+		_packets_sent.load(std::memory_order_relaxed), _packet_send_calls.load(std::memory_order_relaxed)};
+}
+
+/**
+ * Count packets that have been sent.
+ * @param packets The number of packets that were sent completely.
+ * @param send_calls The number of calls to the operating system used for sending.
+ */
+void CountPacketsSent(size_t packets, size_t send_calls)
+{
+	_packets_sent.fetch_add(packets, std::memory_order_relaxed);
+	_packet_send_calls.fetch_add(send_calls, std::memory_order_relaxed);
+}
+
+/**
+ * Free buffers of packets, so the buffers of sent and handled packets are
+ * reused instead of allocating new ones for every packet. Buffers are kept
+ * in two size classes: those that fit a #COMPAT_MTU sized packet, and those
+ * that fit a #TCP_MTU sized packet like the map data.
+ */
+class PacketBufferPool {
+	static constexpr size_t MAX_FREE_BUFFERS = 256; ///< The maximum number of free buffers per size class.
+	std::vector<std::vector<uint8_t>> small{}; ///< Free buffers with room for at least #COMPAT_MTU bytes.
+	std::vector<std::vector<uint8_t>> large{}; ///< Free buffers with room for at least #TCP_MTU bytes.
+
+public:
+	/**
+	 * Whether the pool of this thread has been destroyed. Packets held by
+	 * objects with static storage duration can outlive the pool at exit;
+	 * this flag has no destructor, so it can still be read then.
+	 */
+	static inline thread_local bool destroyed = false;
+
+	~PacketBufferPool()
+	{
+		destroyed = true;
+	}
+
+	/**
+	 * Get an empty buffer for a packet.
+	 * @param limit The maximum size of the packet.
+	 * @return The buffer.
+	 */
+	std::vector<uint8_t> Acquire(size_t limit)
+	{
+		for (auto *free : {limit > COMPAT_MTU ? &this->large : &this->small, &this->small}) {
+			if (free->empty()) continue;
+
+			std::vector<uint8_t> buffer = std::move(free->back());
+			free->pop_back();
+			_packet_buffers_reused.fetch_add(1, std::memory_order_relaxed);
+			return buffer;
+		}
+
+		std::vector<uint8_t> buffer;
+		buffer.reserve(std::min<size_t>(limit, COMPAT_MTU));
+		_packet_buffers_allocated.fetch_add(1, std::memory_order_relaxed);
+		return buffer;
+	}
+
+	/**
+	 * Return the buffer of a packet to the pool.
+	 * @param buffer The buffer.
+	 */
+	void Release(std::vector<uint8_t> &&buffer)
+	{
+		auto &free = buffer.capacity() >= TCP_MTU ? this->large : this->small;
+		if (buffer.capacity() < COMPAT_MTU || free.size() >= MAX_FREE_BUFFERS) return;
+
+		buffer.clear();
+		free.push_back(std::move(buffer));
+	}
+};
+
+/** The pool of packet buffers; per thread, so it needs no locking. */
+static thread_local PacketBufferPool _packet_buffer_pool;
+
+/**
+ * Get an empty buffer for a packet from the pool of this thread.
+ * @param limit The maximum size of the packet.
+ * @return The buffer.
+ */
+static std::vector<uint8_t> AcquirePacketBuffer(size_t limit)
+{
+	if (PacketBufferPool::destroyed) return {};
+	return _packet_buffer_pool.Acquire(limit);
+}
+
 /**
  * Create a packet that is used to read from a network socket.
  * @param cs                The socket handler associated with the socket we are reading from.
@@ -26,7 +128,7 @@
  *                          loose some the data of the packet, so there you pass the maximum
  *                          size for the packet you expect from the network.
  */
-Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size) : pos(0), limit(limit)
+Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size) : pos(0), buffer(AcquirePacketBuffer(limit)), limit(limit)
 {
 	assert(cs != nullptr);
 
@@ -43,7 +145,7 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
  *              the limit as it might break things if the other side is not expecting
  *              much larger packets than what they support.
  */
-Packet::Packet(NetworkSocketHandler *cs, PacketType type, size_t limit) : pos(0), limit(limit), cs(cs)
+Packet::Packet(NetworkSocketHandler *cs, PacketType type, size_t limit) : pos(0), buffer(AcquirePacketBuffer(limit)), limit(limit), cs(cs)
 {
 	/* Allocate space for the the size so we can write that in just before sending the packet. */
 	size_t size = Packet::ENCODED_LENGTH_OF_PACKET_SIZE;
@@ -57,6 +159,12 @@ Packet::Packet(NetworkSocketHandler *cs, PacketType type, size_t limit) : pos(0)
 	this->Send_uint8(type);
 }
 
+/** Return the buffer of the packet to the pool, unless the pool is already gone. */
+Packet::~Packet()
+{
+	if (!PacketBufferPool::destroyed) _packet_buffer_pool.Release(std::move(this->buffer));
+}
+
 
 /**
  * Writes the packet size from the raw packet from packet->size
@@ -77,7 +185,6 @@ void Packet::PrepareToSend()
 	}
 
 	this->pos  = 0; // We start reading from here
-	this->buffer.shrink_to_fit();
 }
 
 /**
@@ -19,6 +19,17 @@
 typedef uint16_t PacketSize; ///< Size of the whole packet.
 typedef uint8_t  PacketType; ///< Identifier for the packet
 
+/** Counters of the work done for transferring packets. */
+struct PacketCounters {
+	uint64_t buffers_allocated = 0; ///< Number of packet buffers that had to be allocated.
+	uint64_t buffers_reused = 0; ///< Number of packet buffers that were taken from the pool.
+	uint64_t packets_sent = 0; ///< Number of TCP packets that have been sent completely.
+	uint64_t send_calls = 0; ///< Number of calls to the operating system to send TCP packets.
+};
+
+PacketCounters GetPacketCounters();
+void CountPacketsSent(size_t packets, size_t send_calls);
+
 /**
  * Trait to mark an enumeration as a PacketType.
  *
@@ -70,6 +81,7 @@ private:
 public:
 	Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size = Packet::ENCODED_LENGTH_OF_PACKET_SIZE);
 	Packet(NetworkSocketHandler *cs, PacketType type, size_t limit = COMPAT_MTU);
+	~Packet();
 
 	/**
 	 * Creates a packet to send
@@ -117,6 +129,27 @@ public:
 
 	size_t RemainingBytesToTransfer() const;
 
+	/**
+	 * Get the bytes that still have to be transferred out of the packet.
+	 * Together with #MarkTransferred this allows sending the bytes of
+	 * several packets with a single call.
+	 * @return The remaining bytes.
+	 */
+	std::span<const uint8_t> GetBytesToTransfer() const
+	{
+		return std::span<const uint8_t>(this->buffer.data() + this->pos, this->RemainingBytesToTransfer());
+	}
+
+	/**
+	 * Mark bytes returned by #GetBytesToTransfer as transferred.
+	 * @param bytes The number of transferred bytes.
+	 */
+	void MarkTransferred(size_t bytes)
+	{
+		assert(bytes <= this->RemainingBytesToTransfer());
+		this->pos += static_cast<PacketSize>(bytes);
+	}
+
 	/**
 	 * Transfer data from the packet to the given function. It starts reading at the
 	 * position the last transfer stopped.
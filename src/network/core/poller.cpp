@@ -0,0 +1,167 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file poller.cpp Implementation of waiting for many sockets to become ready at once. */
+
+#include "../../stdafx.h"
+#include "../../debug.h"
+#include "poller.h"
+
+#include <thread>
+
+#if defined(__linux__)
+#	include <sys/epoll.h>
+#endif /* __linux__ */
+
+#include "../../safeguards.h"
+
+#if defined(__linux__)
+/**
+ * Convert readiness flags to epoll events.
+ * @param flags The flags to convert.
+ * @return The epoll events.
+ */
+static uint32_t ToEpollEvents(SocketReadinessFlags flags)
+{
+	uint32_t events = 0;
+	if (flags.Test(SocketReadiness::Read)) events |= EPOLLIN;
+	if (flags.Test(SocketReadiness::Write)) events |= EPOLLOUT;
+	return events;
+}
+#endif /* __linux__ */
+
+NetworkPoller::NetworkPoller()
+{
+#if defined(__linux__)
+	this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (this->epoll_fd < 0) Debug(net, 0, "epoll_create1() failed, falling back to select(): {}", NetworkError::GetLast().AsString());
+#endif /* __linux__ */
+}
+
+NetworkPoller::~NetworkPoller()
+{
+#if defined(__linux__)
+	if (this->epoll_fd >= 0) close(this->epoll_fd);
+#endif /* __linux__ */
+}
+
+/**
+ * Get the poller for the sockets of the game.
+ * @return The poller.
+ */
+/* static */ NetworkPoller &NetworkPoller::Get()
+{
+	static NetworkPoller poller;
+	return poller;
+}
+
+/**
+ * Start watching a socket, or change what it is watched for.
+ * Calling this when nothing changes is cheap, so it can be called for
+ * every socket before every wait.
+ * @param s The socket to watch.
+ * @param interest The readiness to watch for.
+ */
+void NetworkPoller::Watch(SOCKET s, SocketReadinessFlags interest)
+{
+	auto [it, inserted] = this->interest.try_emplace(s);
+	if (it->second == interest) return;
+	[[maybe_unused]] SocketReadinessFlags old_interest = it->second;
+	it->second = interest;
+
+#if defined(__linux__)
+	if (this->epoll_fd < 0) return;
+
+	/* epoll always reports errors and hang ups, so sockets without interest are removed instead. */
+	int op = old_interest.None() ? EPOLL_CTL_ADD : (interest.None() ? EPOLL_CTL_DEL : EPOLL_CTL_MOD);
+	epoll_event event{};
+	event.events = ToEpollEvents(interest);
+	event.data.fd = s;
+	if (epoll_ctl(this->epoll_fd, op, s, &event) != 0) {
+		Debug(net, 0, "epoll_ctl() failed: {}", NetworkError::GetLast().AsString());
+	}
+#endif /* __linux__ */
+}
+
+/**
+ * Stop watching a socket. This must be called before closing the socket,
+ * as another socket may get the same handle afterwards.
+ * @param s The socket to stop watching.
+ */
+void NetworkPoller::Forget(SOCKET s)
+{
+	auto it = this->interest.find(s);
+	if (it == this->interest.end()) return;
+	[[maybe_unused]] bool watched = it->second.Any();
+	this->interest.erase(it);
+	this->ready.erase(s);
+
+#if defined(__linux__)
+	if (this->epoll_fd >= 0 && watched) epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, s, nullptr);
+#endif /* __linux__ */
+}
+
+/**
+ * Wait until any of the watched sockets is ready, or the timeout expires.
+ * Afterwards #GetReadiness tells which sockets were ready.
+ * @param timeout How long to wait at most; zero to only check.
+ * @return Whether any socket was ready.
+ */
+bool NetworkPoller::Wait(std::chrono::milliseconds timeout)
+{
+	this->ready.clear();
+
+#if defined(__linux__)
+	if (this->epoll_fd >= 0) {
+		/* Room for all sockets, so all ready sockets are found in one call. */
+		static std::vector<epoll_event> events;
+		events.resize(std::max<size_t>(1, this->interest.size()));
+
+		int n = epoll_wait(this->epoll_fd, events.data(), static_cast<int>(events.size()), static_cast<int>(timeout.count()));
+		if (n < 0) {
+			if (errno != EINTR) Debug(net, 0, "epoll_wait() failed: {}", NetworkError::GetLast().AsString());
+			return false;
+		}
+
+		for (int i = 0; i < n; i++) {
+			SocketReadinessFlags &flags = this->ready[events[i].data.fd];
+			/* Errors and hang ups are found by the next read. */
+			if ((events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0) flags.Set(SocketReadiness::Read);
+			if ((events[i].events & EPOLLOUT) != 0) flags.Set(SocketReadiness::Write);
+		}
+		return !this->ready.empty();
+	}
+#endif /* __linux__ */
+
+	/* select() does not wait without any sockets on all platforms. */
+	if (std::ranges::none_of(this->interest, [](const auto &pair) { return pair.second.Any(); })) {
+		std::this_thread::sleep_for(timeout);
+		return false;
+	}
+
+	fd_set read_fd, write_fd;
+	FD_ZERO(&read_fd);
+	FD_ZERO(&write_fd);
+
+	for (const auto &[s, interest] : this->interest) {
+		if (interest.Test(SocketReadiness::Read)) FD_SET(s, &read_fd);
+		if (interest.Test(SocketReadiness::Write)) FD_SET(s, &write_fd);
+	}
+
+	struct timeval tv;
+	tv.tv_sec = static_cast<long>(timeout.count() / 1000);
+	tv.tv_usec = static_cast<long>(timeout.count() % 1000) * 1000;
+	if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) <= 0) return false;
+
+	for (const auto &[s, interest] : this->interest) {
+		SocketReadinessFlags flags{};
+		if (FD_ISSET(s, &read_fd)) flags.Set(SocketReadiness::Read);
+		if (FD_ISSET(s, &write_fd)) flags.Set(SocketReadiness::Write);
+		if (flags.Any()) this->ready[s] = flags;
+	}
+	return !this->ready.empty();
+}
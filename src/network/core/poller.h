@@ -0,0 +1,61 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file poller.h Waiting for many sockets to become ready at once. */
+
+#ifndef NETWORK_CORE_POLLER_H
+#define NETWORK_CORE_POLLER_H
+
+#include "os_abstraction.h"
+#include "../../core/enum_type.hpp"
+
+#include <chrono>
+
+/** The ways a socket can be ready. */
+enum class SocketReadiness : uint8_t {
+	Read, ///< Data can be read from it, or a connection can be accepted.
+	Write, ///< Data can be written to it.
+};
+using SocketReadinessFlags = EnumBitSet<SocketReadiness, uint8_t>;
+
+/**
+ * Keeps track of the sockets of the server, and waits until any of them is
+ * ready in a single call. On Linux this uses epoll, so neither the cost of
+ * waiting nor the number of sockets is bound by select()'s limits; other
+ * platforms fall back to select().
+ */
+class NetworkPoller {
+public:
+	NetworkPoller();
+	~NetworkPoller();
+
+	void Watch(SOCKET s, SocketReadinessFlags interest);
+	void Forget(SOCKET s);
+	bool Wait(std::chrono::milliseconds timeout);
+
+	/**
+	 * Get how a socket was ready during the last wait.
+	 * @param s The socket to check.
+	 * @return The readiness of the socket.
+	 */
+	SocketReadinessFlags GetReadiness(SOCKET s) const
+	{
+		auto it = this->ready.find(s);
+		return it == this->ready.end() ? SocketReadinessFlags{} : it->second;
+	}
+
+	static NetworkPoller &Get();
+
+private:
+	std::unordered_map<SOCKET, SocketReadinessFlags> interest{}; ///< The watched sockets, and what they are watched for.
+	std::unordered_map<SOCKET, SocketReadinessFlags> ready{}; ///< The sockets that were ready during the last wait.
+#if defined(__linux__)
+	int epoll_fd = -1; ///< The epoll instance, or -1 when it could not be created.
+#endif /* __linux__ */
+};
+
+#endif /* NETWORK_CORE_POLLER_H */
@@ -11,6 +11,11 @@
 #include "../../debug.h"
 
 #include "tcp.h"
+#include "poller.h"
+
+#if defined(UNIX)
+#	include <sys/uio.h>
+#endif /* UNIX */
 
 #include "../../safeguards.h"
 
@@ -27,7 +32,10 @@ NetworkTCPSocketHandler::~NetworkTCPSocketHandler()
  */
 void NetworkTCPSocketHandler::CloseSocket()
 {
-	if (this->sock != INVALID_SOCKET) closesocket(this->sock);
+	if (this->sock != INVALID_SOCKET) {
+		NetworkPoller::Get().Forget(this->sock);
+		closesocket(this->sock);
+	}
 	this->sock = INVALID_SOCKET;
 }
 
@@ -78,9 +86,29 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 	if (!this->writable) return SPS_NONE_SENT;
 	if (!this->IsConnected()) return SPS_CLOSED;
 
+	size_t packets_sent = 0;
+	size_t send_calls = 0;
+	SendPacketsState state = SPS_ALL_SENT;
+
 	while (!this->packet_queue.empty()) {
-		Packet &p = *this->packet_queue.front();
-		ssize_t res = p.TransferOut(SocketSender{this->sock});
+#if defined(UNIX)
+		/* Hand several queued packets to the operating system at once. */
+		std::array<iovec, MAX_PACKETS_PER_SEND> iov;
+		size_t count = 0;
+		size_t requested = 0;
+		for (auto it = this->packet_queue.begin(); it != this->packet_queue.end() && count < iov.size(); ++it, ++count) {
+			std::span<const uint8_t> bytes = (*it)->GetBytesToTransfer();
+			iov[count].iov_base = const_cast<uint8_t *>(bytes.data());
+			iov[count].iov_len = bytes.size();
+			requested += bytes.size();
+		}
+		ssize_t res = writev(this->sock, iov.data(), static_cast<int>(count));
+#else
+		size_t requested = this->packet_queue.front()->RemainingBytesToTransfer();
+		ssize_t res = SocketSender{this->sock}(this->packet_queue.front()->GetBytesToTransfer());
+#endif
+		send_calls++;
+
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -89,26 +117,41 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 					Debug(net, 0, "Send failed: {}", err.AsString());
 					this->CloseConnection();
 				}
-				return SPS_CLOSED;
+				state = SPS_CLOSED;
+				break;
 			}
-			return SPS_PARTLY_SENT;
+			state = SPS_PARTLY_SENT;
+			break;
 		}
 		if (res == 0) {
 			/* Client/server has left us :( */
 			if (!closing_down) this->CloseConnection();
-			return SPS_CLOSED;
+			state = SPS_CLOSED;
+			break;
+		}
+
+		/* Go to the next packets, for as far as they have been sent. */
+		for (size_t sent = res; sent > 0;) {
+			Packet &p = *this->packet_queue.front();
+			size_t bytes = std::min(sent, p.RemainingBytesToTransfer());
+			p.MarkTransferred(bytes);
+			sent -= bytes;
+
+			if (p.RemainingBytesToTransfer() == 0) {
+				this->packet_queue.pop_front();
+				packets_sent++;
+			}
 		}
 
-		/* Is this packet sent? */
-		if (p.RemainingBytesToTransfer() == 0) {
-			/* Go to the next packet */
-			this->packet_queue.pop_front();
-		} else {
-			return SPS_PARTLY_SENT;
+		/* Not everything could be sent, so the socket's buffer is full. */
+		if (static_cast<size_t>(res) < requested) {
+			state = SPS_PARTLY_SENT;
+			break;
 		}
 	}
 
-	return SPS_ALL_SENT;
+	CountPacketsSent(packets_sent, send_calls);
+	return state;
 }
 
 /**
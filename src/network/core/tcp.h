@@ -31,6 +31,8 @@ private:
 	std::deque<std::unique_ptr<Packet>> packet_queue{}; ///< Packets that are awaiting delivery. Cannot be std::queue as that does not have a clear() function.
 	std::unique_ptr<Packet> packet_recv = nullptr; ///< Partially received packet
 
+	static constexpr size_t MAX_PACKETS_PER_SEND = 16; ///< Maximum number of packets handed to the operating system at once; the minimum IOV_MAX of POSIX.
+
 public:
 	SOCKET sock = INVALID_SOCKET; ///< The socket currently connected to
 	bool writable = false; ///< Can we write to this socket?
@@ -57,6 +59,19 @@ public:
 	 */
 	bool HasSendQueue() { return !this->packet_queue.empty(); }
 
+	/**
+	 * Whether packets may be received at this moment. When not, there is no
+	 * need to wait for the socket to become readable.
+	 * @return true when #ReceivePacket may return packets.
+	 */
+	virtual bool MayReceive() const { return true; }
+
+	/**
+	 * Get the number of packets pending in the send queue.
+	 * @return The number of packets.
+	 */
+	size_t GetSendQueueLength() const { return this->packet_queue.size(); }
+
 	/**
 	 * Construct a socket handler for a TCP connection.
 	 * @param s The just opened TCP connection.
@@ -63,6 +63,8 @@ enum class PacketAdminType : uint8_t {
 	ServerCommandLogging, ///< The server gives the admin copies of incoming command packets.
 	ServerAuthenticationRequest, ///< The server gives the admin the used authentication method and required parameters.
 	ServerEnableEncryption, ///< The server tells that authentication has completed and requests to enable encryption with the keys of the last \c PacketAdminType::AdminAuthenticationResponse.
+	ServerPerformance, ///< The server gives the admin metrics about its performance.
+	ServerVehiclePositions, ///< The server gives the admin the changed positions of vehicles.
 };
 /** Mark PacketAdminType as a PacketType. */
 template <> struct IsEnumPacketType<PacketAdminType> {
@@ -89,6 +91,8 @@ enum AdminUpdateType : uint8_t {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_PERFORMANCE,     ///< The admin would like to have performance metrics.
+	ADMIN_UPDATE_VEHICLE_POSITIONS, ///< The admin would like to have the positions of vehicles.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -113,6 +117,25 @@ enum AdminCompanyRemoveReason : uint8_t {
 	ADMIN_CRR_END,       ///< Sentinel for end.
 };
 
+/** Parts of a vehicle that changed since the previous \c PacketAdminType::ServerVehiclePositions. */
+enum class AdminVehicleChange : uint8_t {
+	New, ///< The vehicle is new, or its owner changed; its type and owner follow.
+	Position, ///< The position of the vehicle changed.
+	State, ///< The state of the vehicle changed.
+	Removed, ///< The vehicle is gone; together with \c New its ID got reused by the vehicle that follows.
+};
+using AdminVehicleChanges = EnumBitSet<AdminVehicleChange, uint8_t>; ///< Bitset of changes of a vehicle.
+
+/** State of a vehicle, as communicated to admins. */
+enum class AdminVehicleState : uint8_t {
+	Running, ///< The vehicle is on its way.
+	Stopped, ///< The vehicle is stopped outside a depot.
+	InDepot, ///< The vehicle is inside a depot.
+	Loading, ///< The vehicle is loading or unloading at a station.
+	BrokenDown, ///< The vehicle is broken down.
+	Crashed, ///< The vehicle is crashed.
+};
+
 /** Main socket handler for admin related connections. */
 class NetworkAdminSocketHandler : public NetworkTCPSocketHandler {
 protected:
@@ -539,6 +562,67 @@ protected:
 	 */
 	virtual NetworkRecvStatus ReceiveServerRemoteConsoleCommandEnd(Packet &p);
 
+	/**
+	 * Send performance metrics of the server to the admin.
+	 * All durations are in microseconds, over the most recent measurements.
+	 * uint32_t  Frame counter of the server.
+	 * uint8_t   Number of performance elements that follow, each with:
+	 *   uint8_t   ID of the element (\c PerformanceElement).
+	 *   uint32_t  Median processing time.
+	 *   uint32_t  90th percentile of the processing time.
+	 *   uint32_t  99th percentile of the processing time.
+	 *   uint32_t  Longest processing time.
+	 * uint8_t   Number of pool sizes that follow, each as uint32_t; in order
+	 *           vehicles, order lists, stations, road stops,
+	 *           cargo packets, towns, industries and depots.
+	 * uint32_t  Number of link graphs waiting for a job.
+	 * uint32_t  Number of running link graph jobs.
+	 * uint16_t  Number of connected clients.
+	 * uint32_t  Total number of packets queued to be sent to clients.
+	 * uint32_t  Largest number of packets queued for a single client.
+	 * uint32_t  Total number of commands queued to be sent to clients.
+	 * uint8_t   Number of companies that follow, each with:
+	 *   uint8_t   ID of the company.
+	 *   uint16_t  Number of trains.
+	 *   uint16_t  Number of lorries.
+	 *   uint16_t  Number of busses.
+	 *   uint16_t  Number of planes.
+	 *   uint16_t  Number of ships.
+	 *   uint32_t  Number of rail pieces.
+	 *   uint32_t  Number of road pieces.
+	 *   uint32_t  Number of tram pieces.
+	 *   uint32_t  Number of signals.
+	 *   uint32_t  Number of canal pieces.
+	 *   uint32_t  Number of station tiles.
+	 *   uint32_t  Number of airports.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus ReceiveServerPerformance(Packet &p);
+
+	/**
+	 * Send the vehicles that changed since the previous packet to the admin.
+	 * Only primary vehicles, i.e. the front of trains and road vehicles, ships
+	 * and aircraft are sent. When the changes do not fit in one packet, more
+	 * packets follow with the same frame counter.
+	 * uint32_t  Frame counter of the server.
+	 * Until the end of the packet, records of:
+	 *   uint32_t  ID of the vehicle.
+	 *   uint8_t   Changes of the vehicle (\c AdminVehicleChanges), followed by
+	 *             the fields of the changes in this order:
+	 *   With \c AdminVehicleChange::New:
+	 *     uint8_t   Type of the vehicle (\c VehicleType).
+	 *     uint8_t   ID of the owning company.
+	 *   With \c AdminVehicleChange::Position:
+	 *     int32_t   X coordinate; the tile is this divided by 16.
+	 *     int32_t   Y coordinate; the tile is this divided by 16.
+	 *   With \c AdminVehicleChange::State:
+	 *     uint8_t   State of the vehicle (\c AdminVehicleState).
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus ReceiveServerVehiclePositions(Packet &p);
+
 	NetworkRecvStatus HandlePacket(Packet &p);
 public:
 	NetworkRecvStatus CloseConnection(bool error = true) override;
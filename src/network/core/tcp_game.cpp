@@ -88,6 +88,7 @@ NetworkRecvStatus NetworkGameSocketHandler::HandlePacket(Packet &p)
 		case PacketGameType::ClientAck: return this->ReceiveClientAck(p);
 		case PacketGameType::ClientCommand: return this->ReceiveClientCommand(p);
 		case PacketGameType::ServerCommand: return this->ReceiveServerCommand(p);
+		case PacketGameType::ServerCommandBatch: return this->ReceiveServerCommandBatch(p);
 		case PacketGameType::ClientChat: return this->ReceiveClientChat(p);
 		case PacketGameType::ServerChat: return this->ReceiveServerChat(p);
 		case PacketGameType::ServerExternalChat: return this->ReceiveServerExternalChat(p);
@@ -175,6 +176,7 @@ NetworkRecvStatus NetworkGameSocketHandler::ReceiveClientQuit(Packet &) { return
 NetworkRecvStatus NetworkGameSocketHandler::ReceiveClientError(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ClientError); }
 NetworkRecvStatus NetworkGameSocketHandler::ReceiveServerQuit(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ServerQuit); }
 NetworkRecvStatus NetworkGameSocketHandler::ReceiveServerErrorQuit(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ServerErrorQuit); }
+NetworkRecvStatus NetworkGameSocketHandler::ReceiveServerCommandBatch(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ServerCommandBatch); }
 NetworkRecvStatus NetworkGameSocketHandler::ReceiveServerShutdown(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ServerShutdown); }
 NetworkRecvStatus NetworkGameSocketHandler::ReceiveServerNewGame(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ServerNewGame); }
 NetworkRecvStatus NetworkGameSocketHandler::ReceiveServerRemoteConsoleCommand(Packet &) { return this->ReceiveInvalidPacket(PacketGameType::ServerRemoteConsoleCommand); }
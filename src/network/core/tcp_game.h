@@ -120,6 +120,9 @@ enum class PacketGameType : uint8_t {
 	ServerQuit, ///< A server tells that a client has quit.
 	ClientError, ///< A client reports an error to the server.
 	ServerErrorQuit, ///< A server tells that a client has hit an error and did quit.
+
+	/* Sending commands around, in bulk. */
+	ServerCommandBatch, ///< Server distributes the commands of a frame to a client at once.
 };
 /** Mark PacketGameType as PacketType. */
 template <> struct IsEnumPacketType<PacketGameType> {
@@ -371,6 +374,17 @@ protected:
 	 */
 	virtual NetworkRecvStatus ReceiveServerCommand(Packet &p);
 
+	/**
+	 * Sends the DoCommands of a frame to the client at once:
+	 * uint32_t  Frame of execution.
+	 * Followed until the end of the packet by the commands, each being:
+	 * `<var>`   The command, encoded like in #PacketGameType::ServerCommand.
+	 * bool      Whether the command originated from the receiving client.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus ReceiveServerCommandBatch(Packet &p);
+
 	/**
 	 * Sends a chat-packet to the server:
 	 * uint8_t   ID of the action (see NetworkAction).
@@ -11,6 +11,7 @@
 #define NETWORK_CORE_TCP_LISTEN_H
 
 #include "tcp.h"
+#include "poller.h"
 #include "../network.h"
 #include "../network_func.h"
 #include "../network_internal.h"
@@ -101,40 +102,48 @@ public:
 	}
 
 	/**
-	 * Handle the receiving of packets.
-	 * @return true if everything went okay.
+	 * Watch the sockets of the connections and the listeners with the poller.
+	 * Only connections with packets waiting to be sent are watched for being
+	 * writable, the others are writable as far as we know. Connections that
+	 * may not receive anything till the next tick are not watched for being
+	 * readable, as their unread data would otherwise end every wait at once.
 	 */
-	static bool Receive()
+	static void WatchSockets()
 	{
-		fd_set read_fd, write_fd;
-		struct timeval tv;
-
-		FD_ZERO(&read_fd);
-		FD_ZERO(&write_fd);
-
+		NetworkPoller &poller = NetworkPoller::Get();
 
 		for (Tsocket *cs : Tsocket::Iterate()) {
-			FD_SET(cs->sock, &read_fd);
-			FD_SET(cs->sock, &write_fd);
+			SocketReadinessFlags interest{};
+			if (cs->MayReceive()) interest.Set(SocketReadiness::Read);
+			if (cs->HasSendQueue()) interest.Set(SocketReadiness::Write);
+			poller.Watch(cs->sock, interest);
 		}
 
-		/* take care of listener port */
 		for (auto &s : sockets) {
-			FD_SET(s.first, &read_fd);
+			poller.Watch(s.first, SocketReadiness::Read);
 		}
+	}
 
-		tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-		if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+	/**
+	 * Handle the receiving of packets, for the sockets that were ready
+	 * during the last wait of the poller.
+	 * @return true if everything went okay.
+	 * @see WatchSockets
+	 */
+	static bool Receive()
+	{
+		const NetworkPoller &poller = NetworkPoller::Get();
 
 		/* accept clients.. */
 		for (auto &s : sockets) {
-			if (FD_ISSET(s.first, &read_fd)) AcceptClient(s.first);
+			if (poller.GetReadiness(s.first).Test(SocketReadiness::Read)) AcceptClient(s.first);
 		}
 
 		/* read stuff from clients */
 		for (Tsocket *cs : Tsocket::Iterate()) {
-			cs->writable = !!FD_ISSET(cs->sock, &write_fd);
-			if (FD_ISSET(cs->sock, &read_fd)) {
+			SocketReadinessFlags readiness = poller.GetReadiness(cs->sock);
+			cs->writable = !cs->HasSendQueue() || readiness.Test(SocketReadiness::Write);
+			if (readiness.Test(SocketReadiness::Read)) {
 				cs->ReceivePackets();
 			}
 		}
@@ -170,6 +179,7 @@ public:
 	static void CloseListeners()
 	{
 		for (auto &s : sockets) {
+			NetworkPoller::Get().Forget(s.first);
 			closesocket(s.first);
 		}
 		sockets.clear();
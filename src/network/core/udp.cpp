@@ -12,6 +12,7 @@
 #include "../../debug.h"
 #include "network_game_info.h"
 #include "udp.h"
+#include "poller.h"
 
 #include "../../safeguards.h"
 
@@ -48,6 +49,11 @@ bool NetworkUDPSocketHandler::Listen()
 		addr.Listen(SOCK_DGRAM, &this->sockets);
 	}
 
+	/* Wake up a waiting dedicated server for received packets as well. */
+	for (auto &s : this->sockets) {
+		NetworkPoller::Get().Watch(s.first, SocketReadiness::Read);
+	}
+
 	return !this->sockets.empty();
 }
 
@@ -57,6 +63,7 @@ bool NetworkUDPSocketHandler::Listen()
 void NetworkUDPSocketHandler::CloseSocket()
 {
 	for (auto &s : this->sockets) {
+		NetworkPoller::Get().Forget(s.first);
 		closesocket(s.first);
 	}
 	this->sockets.clear();
@@ -16,6 +16,7 @@
 #include "network_admin.h"
 #include "network_client.h"
 #include "network_query.h"
+#include "network_loadtest.h"
 #include "network_server.h"
 #include "network_content.h"
 #include "network_udp.h"
@@ -38,11 +39,15 @@
 #include "../error.h"
 #include "../misc_cmd.h"
 #include "../core/string_builder.hpp"
+#include "core/poller.h"
+#include "network_replay.h"
+#include "../progress.h"
 #ifdef DEBUG_DUMP_COMMANDS
 #	include "../fileio_func.h"
 #	include "../core/string_consumer.hpp"
 #endif
 #include <charconv>
+#include <thread>
 
 #include "table/strings.h"
 
@@ -69,6 +74,7 @@ bool _network_server;     ///< network-server is active
 bool _network_available;  ///< is network mode available?
 bool _network_dedicated;  ///< are we a dedicated server?
 bool _is_network_server;  ///< Does this client wants to be a network-server?
+bool _network_catching_up; ///< Is the client running frames back to back to catch up with the server?
 ClientID _network_own_client_id;      ///< Our client identifier.
 ClientID _redirect_console_to_client; ///< If not invalid, redirect the console output to a client.
 uint8_t _network_reconnect;             ///< Reconnect timeout
@@ -1087,6 +1093,11 @@ static bool NetworkReceive()
 {
 	bool result;
 	if (_network_server) {
+		/* Find all ready sockets of the server at once. */
+		ServerNetworkAdminSocketHandler::WatchSockets();
+		ServerNetworkGameSocketHandler::WatchSockets();
+		NetworkPoller::Get().Wait(std::chrono::milliseconds::zero());
+
 		ServerNetworkAdminSocketHandler::Receive();
 		result = ServerNetworkGameSocketHandler::Receive();
 	} else {
@@ -1108,6 +1119,32 @@ static void NetworkSend()
 	NetworkGameSocketHandler::ProcessDeferredDeletions();
 }
 
+/**
+ * Wait until a socket of the server becomes ready or the timeout expires,
+ * and handle the sockets that became ready. This way a dedicated server
+ * handles traffic, like map downloads, as soon as possible instead of only
+ * at the next tick, and sleeps otherwise.
+ * @param timeout How long to wait at most.
+ */
+void NetworkServerWaitForIO(std::chrono::steady_clock::duration timeout)
+{
+	if (!_networking || !_network_server || HasModalProgress()) {
+		std::this_thread::sleep_for(timeout);
+		return;
+	}
+
+	ServerNetworkAdminSocketHandler::WatchSockets();
+	ServerNetworkGameSocketHandler::WatchSockets();
+	/* Round up, so it does not spin while less than a millisecond is left. */
+	if (!NetworkPoller::Get().Wait(std::chrono::ceil<std::chrono::milliseconds>(timeout))) return;
+
+	ServerNetworkAdminSocketHandler::Receive();
+	ServerNetworkGameSocketHandler::Receive();
+	NetworkGameSocketHandler::ProcessDeferredDeletions();
+	NetworkSend();
+	NetworkBackgroundUDPLoop();
+}
+
 /**
  * We have to do some (simple) background stuff that runs normally,
  * even when we are not in multiplayer. For example stuff needed
@@ -1120,11 +1157,36 @@ void NetworkBackgroundLoop()
 	TCPConnecter::CheckCallbacks();
 	NetworkHTTPSocketHandler::HTTPReceive();
 	QueryNetworkGameSocketHandler::SendReceive();
+	LoadTestNetworkGameSocketHandler::SendReceive();
 	NetworkGameSocketHandler::ProcessDeferredDeletions();
 
 	NetworkBackgroundUDPLoop();
 }
 
+static PacketCounters _packet_counters_of_tick; ///< The work done for transferring packets during the last tick.
+
+/** Determine the work done for transferring packets since the previous tick. */
+static void UpdatePacketCountersOfTick()
+{
+	static PacketCounters previous{};
+	PacketCounters current = GetPacketCounters();
+
+	_packet_counters_of_tick.buffers_allocated = current.buffers_allocated - previous.buffers_allocated;
+	_packet_counters_of_tick.buffers_reused = current.buffers_reused - previous.buffers_reused;
+	_packet_counters_of_tick.packets_sent = current.packets_sent - previous.packets_sent;
+	_packet_counters_of_tick.send_calls = current.send_calls - previous.send_calls;
+	previous = current;
+}
+
+/**
+ * Get the work done for transferring packets during the last tick.
+ * @return The counters of the last tick.
+ */
+PacketCounters NetworkGetPacketCountersOfTick()
+{
+	return _packet_counters_of_tick;
+}
+
 /**
  * The main loop called from ttd.c.
  * @note Here we also have to do StateGameLoop if needed!
@@ -1133,6 +1195,8 @@ void NetworkGameLoop()
 {
 	if (!_networking) return;
 
+	UpdatePacketCountersOfTick();
+
 	if (!NetworkReceive()) return;
 
 	if (_network_server) {
@@ -1291,6 +1355,7 @@ void NetworkGameLoop()
 
 		/* Then we make the frame */
 		StateGameLoop();
+		NetworkReplayRecordTick();
 
 		_sync_seed_1 = _random.state[0];
 #ifdef NETWORK_SEND_DOUBLE_SEED
@@ -1301,9 +1366,11 @@ void NetworkGameLoop()
 	} else {
 		/* Client */
 
-		/* Make sure we are at the frame were the server is (quick-frames) */
-		if (_frame_counter_server > _frame_counter) {
-			/* Run a number of frames; when things go bad, get out. */
+		/* When more than a day behind, e.g. after downloading the map, catch up without drawing. */
+		if (_network_catching_up || _frame_counter_server > _frame_counter + Ticks::DAY_TICKS) {
+			if (!ClientNetworkGameSocketHandler::CatchUp()) return;
+		} else if (_frame_counter_server > _frame_counter) {
+			/* Make sure we are at the frame were the server is (quick-frames); when things go bad, get out. */
 			while (_frame_counter_server > _frame_counter) {
 				if (!ClientNetworkGameSocketHandler::GameLoop()) return;
 			}
@@ -1340,6 +1407,7 @@ void NetworkStartUp()
 /** This shuts the network down */
 void NetworkShutDown()
 {
+	NetworkLoadTestStop();
 	NetworkDisconnect();
 	NetworkHTTPUninitialize();
 	NetworkUDPClose();
@@ -22,6 +22,16 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../framerate_type.h"
+#include "../vehicle_base.h"
+#include "../order_base.h"
+#include "../station_base.h"
+#include "../roadstop_base.h"
+#include "../cargopacket.h"
+#include "../town.h"
+#include "../industry.h"
+#include "../depot_base.h"
+#include "../linkgraph/linkgraphschedule.h"
 
 #include "table/strings.h"
 
@@ -43,6 +53,9 @@ static NetworkAuthenticationDefaultAuthorizedKeyHandler _admin_authorized_key_ha
 /** The timeout for authorisation of the client. */
 static const std::chrono::seconds ADMIN_AUTHORISATION_TIMEOUT{10};
 
+/** Number of most recent measurements the performance percentiles are calculated over. */
+static const int ADMIN_PERFORMANCE_MEASUREMENTS = 512;
+
 
 /** Frequencies, which may be registered for a certain update type. */
 static const AdminUpdateFrequencies _admin_update_type_frequencies[] = {
@@ -56,6 +69,8 @@ static const AdminUpdateFrequencies _admin_update_type_frequencies[] = {
 	{AdminUpdateFrequency::Poll,                                                                                                                                                          }, // ADMIN_UPDATE_CMD_NAMES
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_CMD_LOGGING
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_GAMESCRIPT
+	{AdminUpdateFrequency::Poll, AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_PERFORMANCE
+	{AdminUpdateFrequency::Poll, AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_VEHICLE_POSITIONS
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -459,6 +474,218 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send the performance metrics of the server.
+ * @return The new state the network.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendPerformance()
+{
+	/* The elements of the game loop, followed by the scripts. */
+	static const PerformanceElement elements[] = {
+		PFE_GAMELOOP, PFE_GL_ECONOMY, PFE_GL_TRAINS, PFE_GL_ROADVEHS, PFE_GL_SHIPS, PFE_GL_AIRCRAFT, PFE_GL_LANDSCAPE, PFE_GL_LINKGRAPH, PFE_ALLSCRIPTS,
+	};
+
+	auto p = std::make_unique<Packet>(this, PacketAdminType::ServerPerformance);
+
+	p->Send_uint32(_frame_counter);
+
+	p->Send_uint8(static_cast<uint8_t>(std::size(elements)));
+	for (PerformanceElement elem : elements) {
+		PerformancePercentiles percentiles = GetPerformancePercentiles(elem, ADMIN_PERFORMANCE_MEASUREMENTS);
+		p->Send_uint8(elem);
+		p->Send_uint32(ClampTo<uint32_t>(percentiles.p50));
+		p->Send_uint32(ClampTo<uint32_t>(percentiles.p90));
+		p->Send_uint32(ClampTo<uint32_t>(percentiles.p99));
+		p->Send_uint32(ClampTo<uint32_t>(percentiles.max));
+	}
+
+	const size_t pool_sizes[] = {
+		Vehicle::GetNumItems(), OrderList::GetNumItems(), BaseStation::GetNumItems(), RoadStop::GetNumItems(),
+		CargoPacket::GetNumItems(), Town::GetNumItems(), Industry::GetNumItems(), Depot::GetNumItems(),
+	};
+	p->Send_uint8(static_cast<uint8_t>(std::size(pool_sizes)));
+	for (size_t size : pool_sizes) p->Send_uint32(ClampTo<uint32_t>(size));
+
+	p->Send_uint32(ClampTo<uint32_t>(LinkGraphSchedule::instance.GetScheduledCount()));
+	p->Send_uint32(ClampTo<uint32_t>(LinkGraphSchedule::instance.GetRunning().size()));
+
+	size_t total_packets = 0;
+	size_t max_packets = 0;
+	size_t total_commands = 0;
+	for (const NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
+		total_packets += cs->GetSendQueueLength();
+		max_packets = std::max(max_packets, cs->GetSendQueueLength());
+		total_commands += cs->outgoing_queue.size();
+	}
+	p->Send_uint16(ClampTo<uint16_t>(NetworkClientSocket::GetNumItems()));
+	p->Send_uint32(ClampTo<uint32_t>(total_packets));
+	p->Send_uint32(ClampTo<uint32_t>(max_packets));
+	p->Send_uint32(ClampTo<uint32_t>(total_commands));
+
+	NetworkCompanyStatsArray company_stats = NetworkGetCompanyStats();
+	p->Send_uint8(ClampTo<uint8_t>(Company::GetNumItems()));
+	for (const Company *company : Company::Iterate()) {
+		const CompanyInfrastructure &infrastructure = company->infrastructure;
+
+		p->Send_uint8(company->index);
+		for (uint16_t value : company_stats[company->index].num_vehicle) p->Send_uint16(value);
+		p->Send_uint32(infrastructure.GetRailTotal());
+		p->Send_uint32(infrastructure.GetRoadTotal());
+		p->Send_uint32(infrastructure.GetTramTotal());
+		p->Send_uint32(infrastructure.signal);
+		p->Send_uint32(infrastructure.water);
+		p->Send_uint32(infrastructure.station);
+		p->Send_uint32(infrastructure.airport);
+	}
+
+	this->SendPacket(std::move(p));
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+/**
+ * Get the state of a vehicle as communicated to admins.
+ * @param v The vehicle to get the state of.
+ * @return The state.
+ */
+static AdminVehicleState GetAdminVehicleState(const Vehicle *v)
+{
+	if (v->vehstatus.Test(VehState::Crashed)) return AdminVehicleState::Crashed;
+	if (v->breakdown_ctr == 1) return AdminVehicleState::BrokenDown;
+	if (v->IsChainInDepot()) return AdminVehicleState::InDepot;
+	if (v->vehstatus.Test(VehState::Stopped)) return AdminVehicleState::Stopped;
+	if (v->current_order.IsType(OT_LOADING)) return AdminVehicleState::Loading;
+	return AdminVehicleState::Running;
+}
+
+/**
+ * Get what admins get to know about the primary vehicles, i.e. the front of
+ * trains and road vehicles, ships and aircraft.
+ * @return The information, indexed by vehicle ID; valid until the next call.
+ */
+static std::span<const AdminVehicleInfo> GetAdminVehicleInfos()
+{
+	static std::vector<AdminVehicleInfo> vehicles;
+
+	vehicles.assign(Vehicle::GetPoolSize(), {});
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		if (!v->IsPrimaryVehicle()) continue;
+		vehicles[v->index.base()] = {v->x_pos, v->y_pos, v->type, v->owner, v->generation, GetAdminVehicleState(v)};
+	}
+	return vehicles;
+}
+
+/**
+ * Check whether this is the same vehicle as the one an admin got to know
+ * before, or whether its ID got reused for another vehicle.
+ * @param other What the admin got to know before.
+ * @return \c true iff both describe the same vehicle.
+ */
+bool AdminVehicleInfo::IsSameVehicle(const AdminVehicleInfo &other) const
+{
+	return this->type == other.type && this->generation == other.generation;
+}
+
+/** Forget what the admin knows, so the next update contains all vehicles. */
+void AdminVehiclePositionFeed::Reset()
+{
+	this->sent.clear();
+	this->cursor = 0;
+}
+
+/**
+ * Write the vehicles that changed since the previous update.
+ * When the changes do not fit in \a max_bytes, the update is cut short and
+ * the next update continues where this one stopped; the vehicles that were
+ * skipped are still different from what the admin knows, so nothing is lost.
+ * @param cs The socket handler the packets are for.
+ * @param vehicles The current vehicles, indexed by vehicle ID.
+ * @param frame The frame counter to put in the packets.
+ * @param max_bytes The maximum number of bytes of vehicle records to write.
+ * @return The packets to send, if any.
+ */
+std::vector<std::unique_ptr<Packet>> AdminVehiclePositionFeed::WriteChanges(NetworkSocketHandler *cs, std::span<const AdminVehicleInfo> vehicles, uint32_t frame, size_t max_bytes)
+{
+	std::vector<std::unique_ptr<Packet>> packets;
+
+	size_t count = std::max(vehicles.size(), this->sent.size());
+	if (count == 0) return packets;
+
+	this->sent.resize(count);
+	if (this->cursor >= count) this->cursor = 0;
+
+	std::unique_ptr<Packet> p;
+	size_t bytes = 0;
+	for (size_t n = 0; n < count; n++) {
+		size_t index = (this->cursor + n) % count;
+		AdminVehicleInfo &sent = this->sent[index];
+		const AdminVehicleInfo current = index < vehicles.size() ? vehicles[index] : AdminVehicleInfo{};
+
+		AdminVehicleChanges changes{};
+		if (current.type == VEH_INVALID) {
+			if (sent.type == VEH_INVALID) continue;
+			changes.Set(AdminVehicleChange::Removed);
+		} else if (!current.IsSameVehicle(sent)) {
+			/* When the ID got reused, the admin has to forget the old vehicle first. */
+			if (sent.type != VEH_INVALID) changes.Set(AdminVehicleChange::Removed);
+			changes.Set({AdminVehicleChange::New, AdminVehicleChange::Position, AdminVehicleChange::State});
+		} else {
+			/* The owner changes when companies merge; send it like for a new vehicle. */
+			if (current.owner != sent.owner) changes.Set(AdminVehicleChange::New);
+			if (current.x != sent.x || current.y != sent.y) changes.Set(AdminVehicleChange::Position);
+			if (current.state != sent.state) changes.Set(AdminVehicleChange::State);
+			if (changes.None()) continue;
+		}
+
+		size_t size = sizeof(uint32_t) + sizeof(uint8_t);
+		if (changes.Test(AdminVehicleChange::New)) size += 2 * sizeof(uint8_t);
+		if (changes.Test(AdminVehicleChange::Position)) size += 2 * sizeof(int32_t);
+		if (changes.Test(AdminVehicleChange::State)) size += sizeof(uint8_t);
+
+		if (bytes + size > max_bytes) {
+			this->cursor = index;
+			break;
+		}
+		bytes += size;
+
+		if (p != nullptr && !p->CanWriteToPacket(size)) packets.push_back(std::move(p));
+		if (p == nullptr) {
+			p = std::make_unique<Packet>(cs, PacketAdminType::ServerVehiclePositions);
+			p->Send_uint32(frame);
+		}
+
+		p->Send_uint32(static_cast<uint32_t>(index));
+		p->Send_uint8(changes.base());
+		if (changes.Test(AdminVehicleChange::New)) {
+			p->Send_uint8(current.type);
+			p->Send_uint8(current.owner.base());
+		}
+		if (changes.Test(AdminVehicleChange::Position)) {
+			p->Send_uint32(static_cast<uint32_t>(current.x));
+			p->Send_uint32(static_cast<uint32_t>(current.y));
+		}
+		if (changes.Test(AdminVehicleChange::State)) p->Send_uint8(to_underlying(current.state));
+
+		sent = current;
+	}
+
+	if (p != nullptr) packets.push_back(std::move(p));
+	return packets;
+}
+
+/**
+ * Send the vehicles that changed since the previous update.
+ * @param vehicles The current vehicles, indexed by vehicle ID.
+ * @param max_bytes The maximum number of bytes of vehicle records to send.
+ * @return The new state the network.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendVehiclePositions(std::span<const AdminVehicleInfo> vehicles, size_t max_bytes)
+{
+	for (auto &p : this->vehicle_positions.WriteChanges(this, vehicles, _frame_counter, max_bytes)) {
+		this->SendPacket(std::move(p));
+	}
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -713,6 +940,10 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::ReceiveAdminUpdateFrequency(P
 	this->update_frequency[type] = freq;
 
 	if (type == ADMIN_UPDATE_CONSOLE) DebugReconsiderSendRemoteMessages();
+	if (type == ADMIN_UPDATE_VEHICLE_POSITIONS) {
+		/* Start over, so the first update contains all vehicles. */
+		this->vehicle_positions.Reset();
+	}
 
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -774,6 +1005,17 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::ReceiveAdminPoll(Packet &p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_PERFORMANCE:
+			/* The admin is requesting the performance metrics. */
+			this->SendPerformance();
+			break;
+
+		case ADMIN_UPDATE_VEHICLE_POSITIONS:
+			/* The admin is requesting all vehicles; forget what it knows, and send them without limit. */
+			this->vehicle_positions.Reset();
+			this->SendVehiclePositions(GetAdminVehicleInfos(), SIZE_MAX);
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			Debug(net, 1, "[admin] Not supported poll {} ({}) from '{}' ({}).", type, d1, this->admin_name, this->admin_version);
@@ -1137,3 +1379,36 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 		}
 	}
 }
+
+/**
+ * Send the performance metrics to the admins that want them, every
+ * network.admin_performance_interval ticks.
+ */
+void NetworkAdminPerformance()
+{
+	if (_frame_counter % _settings_client.network.admin_performance_interval != 0) return;
+
+	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::IterateActive()) {
+		if (as->update_frequency[ADMIN_UPDATE_PERFORMANCE].Test(AdminUpdateFrequency::Automatic)) {
+			as->SendPerformance();
+		}
+	}
+}
+
+/**
+ * Send the changed vehicles to the admins that want them, every
+ * network.admin_vehicle_positions_interval ticks.
+ */
+void NetworkAdminVehiclePositions()
+{
+	if (_frame_counter % _settings_client.network.admin_vehicle_positions_interval != 0) return;
+
+	std::span<const AdminVehicleInfo> vehicles;
+	for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::IterateActive()) {
+		if (as->update_frequency[ADMIN_UPDATE_VEHICLE_POSITIONS].Test(AdminUpdateFrequency::Automatic)) {
+			/* Collect the vehicles once, for all admins. */
+			if (vehicles.data() == nullptr) vehicles = GetAdminVehicleInfos();
+			as->SendVehiclePositions(vehicles, _settings_client.network.admin_vehicle_positions_bytes);
+		}
+	}
+}
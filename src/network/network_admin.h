@@ -13,6 +13,11 @@
 #include "network_internal.h"
 #include "core/tcp_listen.h"
 #include "core/tcp_admin.h"
+#include "../company_type.h"
+#include "../engine_type.h"
+#include "../transport_type.h"
+#include "../vehicle_type.h"
+#include "../timer/timer_game_calendar.h"
 
 extern AdminID _redirect_console_to_admin;
 
@@ -22,10 +27,35 @@ using NetworkAdminSocketPool = Pool<ServerNetworkAdminSocketHandler, AdminID, 2,
 /** Pool with all admin connections. */
 extern NetworkAdminSocketPool _networkadminsocket_pool;
 
+/** What an admin gets to know about a vehicle. */
+struct AdminVehicleInfo {
+	int32_t x = 0; ///< X coordinate of the vehicle.
+	int32_t y = 0; ///< Y coordinate of the vehicle.
+	VehicleType type = VEH_INVALID; ///< Type of the vehicle; \c VEH_INVALID when there is no vehicle.
+	Owner owner = INVALID_OWNER; ///< Owner of the vehicle.
+	uint64_t generation = 0; ///< Vehicle::generation of the vehicle, which differs when its ID got reused.
+	AdminVehicleState state = AdminVehicleState::Running; ///< State of the vehicle.
+
+	bool IsSameVehicle(const AdminVehicleInfo &other) const;
+};
+
+/**
+ * Keeps track of what an admin knows about the vehicles, and writes the
+ * changes as \c PacketAdminType::ServerVehiclePositions packets.
+ */
+class AdminVehiclePositionFeed {
+	std::vector<AdminVehicleInfo> sent{}; ///< What the admin knows about the vehicles, indexed by vehicle ID.
+	size_t cursor = 0; ///< Vehicle ID to continue with when the previous update was cut short.
+public:
+	void Reset();
+	std::vector<std::unique_ptr<Packet>> WriteChanges(NetworkSocketHandler *cs, std::span<const AdminVehicleInfo> vehicles, uint32_t frame, size_t max_bytes);
+};
+
 /** Class for handling the server side of the game connection. */
 class ServerNetworkAdminSocketHandler : public NetworkAdminSocketPool::PoolItem<&_networkadminsocket_pool>, public NetworkAdminSocketHandler, public TCPListenHandler<ServerNetworkAdminSocketHandler, PacketAdminType, PacketAdminType::ServerFull, PacketAdminType::ServerBanned> {
 private:
 	std::unique_ptr<NetworkAuthenticationServerHandler> authentication_handler = nullptr; ///< The handler for the authentication.
+	AdminVehiclePositionFeed vehicle_positions{}; ///< What the admin knows about the vehicles.
 protected:
 	NetworkRecvStatus ReceiveAdminJoin(Packet &p) override;
 	NetworkRecvStatus ReceiveAdminQuit(Packet &p) override;
@@ -68,6 +98,8 @@ public:
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
 	NetworkRecvStatus SendCompanyEconomy();
 	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendPerformance();
+	NetworkRecvStatus SendVehiclePositions(std::span<const AdminVehicleInfo> vehicles, size_t max_bytes);
 
 	NetworkRecvStatus SendChat(NetworkAction action, NetworkChatDestinationType desttype, ClientID client_id, std::string_view msg, int64_t data);
 	NetworkRecvStatus SendRcon(uint16_t colour, std::string_view command);
@@ -126,5 +158,7 @@ void NetworkServerSendAdminRcon(AdminID admin_index, TextColour colour_code, std
 void NetworkAdminConsole(std::string_view origin, std::string_view string);
 void NetworkAdminGameScript(std::string_view json);
 void NetworkAdminCmdLogging(const NetworkClientSocket *owner, const CommandPacket &cp);
+void NetworkAdminPerformance();
+void NetworkAdminVehiclePositions();
 
 #endif /* NETWORK_ADMIN_H */
@@ -111,6 +111,7 @@ ClientNetworkGameSocketHandler::~ClientNetworkGameSocketHandler()
 {
 	assert(ClientNetworkGameSocketHandler::my_client == this);
 	ClientNetworkGameSocketHandler::my_client = nullptr;
+	_network_catching_up = false;
 
 	delete this->GetInfo();
 }
@@ -261,6 +262,60 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	return true;
 }
 
+/**
+ * Run frames back to back until we are at the frame of the server. Drawing,
+ * sounds and game tick events of windows are skipped meanwhile, and frames
+ * are only run for a short while per call, so packets keep flowing and the
+ * progress gets shown.
+ * @return Whether everything went okay, or not.
+ */
+/* static */ bool ClientNetworkGameSocketHandler::CatchUp()
+{
+	static uint32_t first_frame; ///< The frame the catching up started at.
+	static NetworkJoinStatus previous_status; ///< The join status before catching up.
+
+	if (!_network_catching_up) {
+		Debug(net, 3, "Catching up {} frames with the server", _frame_counter_server - _frame_counter);
+		_network_catching_up = true;
+		first_frame = _frame_counter;
+		previous_status = _network_join_status;
+
+		Debug(net, 9, "Client::join_status = CatchingUp");
+		_network_join_status = NetworkJoinStatus::CatchingUp;
+		ShowJoinStatusWindow();
+	}
+
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+	while (_frame_counter_server > _frame_counter && std::chrono::steady_clock::now() < deadline) {
+		if (!GameLoop()) {
+			_network_catching_up = false;
+			return false;
+		}
+	}
+
+	_network_join_frames = _frame_counter - first_frame;
+	_network_join_frames_total = _frame_counter_server - first_frame;
+	SetWindowDirty(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
+
+	if (_frame_counter_server > _frame_counter) return true;
+
+	Debug(net, 3, "Caught up with the server after {} frames", _network_join_frames);
+	_network_catching_up = false;
+
+	/* Nothing got drawn while catching up. */
+	MarkWholeScreenDirty();
+
+	/* The new company might not have been made yet; otherwise we are done joining. */
+	if (previous_status == NetworkJoinStatus::Registering && _network_join_status == NetworkJoinStatus::CatchingUp && !Company::IsValidID(_local_company)) {
+		_network_join_status = NetworkJoinStatus::Registering;
+		SetWindowDirty(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
+	} else {
+		CloseWindowById(WC_NETWORK_STATUS_WINDOW, WN_NETWORK_STATUS_WINDOW_JOIN);
+	}
+
+	return true;
+}
+
 
 /** Our client's connection. */
 ClientNetworkGameSocketHandler * ClientNetworkGameSocketHandler::my_client = nullptr;
@@ -979,6 +1034,30 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::ReceiveServerCommand(Packet &p
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+NetworkRecvStatus ClientNetworkGameSocketHandler::ReceiveServerCommandBatch(Packet &p)
+{
+	if (this->status != STATUS_ACTIVE) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	uint32_t frame = p.Recv_uint32();
+	while (p.CanReadFromPacket(1)) {
+		CommandPacket cp;
+		auto err = this->ReceiveCommand(p, cp);
+		cp.frame  = frame;
+		cp.my_cmd = p.Recv_bool();
+
+		Debug(net, 9, "Client::ReceiveServerCommandBatch(): cmd={}, frame={}", cp.cmd, cp.frame);
+
+		if (err.has_value()) {
+			IConsolePrint(CC_WARNING, "Dropping server connection due to {}.", *err);
+			return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+		}
+
+		this->incoming_queue.push_back(std::move(cp));
+	}
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 NetworkRecvStatus ClientNetworkGameSocketHandler::ReceiveServerChat(Packet &p)
 {
 	if (this->status != STATUS_ACTIVE) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
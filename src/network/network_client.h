@@ -57,6 +57,7 @@ protected:
 	NetworkRecvStatus ReceiveServerFrame(Packet &p) override;
 	NetworkRecvStatus ReceiveServerSync(Packet &p) override;
 	NetworkRecvStatus ReceiveServerCommand(Packet &p) override;
+	NetworkRecvStatus ReceiveServerCommandBatch(Packet &p) override;
 	NetworkRecvStatus ReceiveServerChat(Packet &p) override;
 	NetworkRecvStatus ReceiveServerExternalChat(Packet &p) override;
 	NetworkRecvStatus ReceiveServerQuit(Packet &p) override;
@@ -98,6 +99,7 @@ public:
 	static void Send();
 	static bool Receive();
 	static bool GameLoop();
+	static bool CatchUp();
 };
 
 /** Helper to make the code look somewhat nicer. */
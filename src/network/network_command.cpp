@@ -11,6 +11,7 @@
 #include "network_admin.h"
 #include "network_client.h"
 #include "network_server.h"
+#include "network_replay.h"
 #include "../command_func.h"
 #include "../company_func.h"
 #include "../settings_type.h"
@@ -212,6 +213,9 @@ void NetworkSendCommand(Commands cmd, StringID err_message, CommandCallback *cal
 	c.callback = callback;
 	c.data     = cmd_data;
 
+	/* The replay contains every command that was executed, so commands posted while replaying would be executed twice. */
+	if (_network_replaying) return;
+
 	if (_network_server) {
 		/* If we are the server, we queue the command in our 'special' queue.
 		 *   In theory, we could execute the command right away, but then the
@@ -233,18 +237,18 @@ void NetworkSendCommand(Commands cmd, StringID err_message, CommandCallback *cal
 }
 
 /**
- * Sync our local command queue to the command queue of the given
- * socket. This is needed for the case where we receive a command
- * before saving the game for a joining client, but without the
+ * Sync our local command queue to the given command queue, e.g.
+ * that of a map snapshot. This is needed for the case where we receive
+ * a command before saving the game for a joining client, but without the
  * execution of those commands. Not syncing those commands means
  * that the client will never get them and as such will be in a
  * desynced state from the time it started with joining.
- * @param cs The client to sync the queue to.
+ * @param queue The queue to sync the commands to.
  */
-void NetworkSyncCommandQueue(NetworkClientSocket *cs)
+void NetworkSyncCommandQueue(CommandQueue &queue)
 {
 	for (auto &p : _local_execution_queue) {
-		CommandPacket &c = cs->outgoing_queue.emplace_back(p);
+		CommandPacket &c = queue.emplace_back(p);
 		c.callback = nullptr;
 	}
 }
@@ -270,6 +274,8 @@ void NetworkExecuteLocalCommandQueue()
 			FatalError("[net] Trying to execute a packet in the past!");
 		}
 
+		if (_network_server) NetworkReplayRecordCommand(*cp);
+
 		/* We can execute this command */
 		_current_company = cp->company;
 		size_t cb_index = FindCallbackIndex(cp->callback);
@@ -283,6 +289,18 @@ void NetworkExecuteLocalCommandQueue()
 	_current_company = _local_company;
 }
 
+/**
+ * Execute a command from a replay. The callback of the original command
+ * belonged to another session, so the command is executed without one.
+ * @param cp The command to execute.
+ */
+void NetworkExecuteReplayCommand(const CommandPacket &cp)
+{
+	_current_company = cp.company;
+	_cmd_dispatch[cp.cmd].Unpack[0](cp);
+	_current_company = _local_company;
+}
+
 /**
  * Free the local command queues.
  */
@@ -301,6 +319,8 @@ static void DistributeCommandPacket(CommandPacket &cp, const NetworkClientSocket
 {
 	CommandCallback *callback = cp.callback;
 	cp.frame = _frame_counter_max + 1;
+	/* Encode the command once for all clients that did not send it. */
+	cp.encoded = std::make_shared<const std::vector<uint8_t>>(NetworkEncodeCommand(cp, nullptr));
 
 	for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
 		if (cs->status >= NetworkClientSocket::STATUS_MAP) {
@@ -312,6 +332,8 @@ static void DistributeCommandPacket(CommandPacket &cp, const NetworkClientSocket
 		}
 	}
 
+	NetworkRecordMapSnapshotCommand(cp);
+
 	cp.callback = (nullptr != owner) ? nullptr : callback;
 	cp.my_cmd = (nullptr == owner);
 	_local_execution_queue.push_back(cp);
@@ -393,17 +415,38 @@ std::optional<std::string_view> NetworkGameSocketHandler::ReceiveCommand(Packet
  */
 void NetworkGameSocketHandler::SendCommand(Packet &p, const CommandPacket &cp)
 {
-	p.Send_uint8(cp.company);
-	p.Send_uint16(to_underlying(cp.cmd));
-	p.Send_uint16(cp.err_msg);
-	p.Send_buffer(cp.data);
+	std::vector<uint8_t> encoded = NetworkEncodeCommand(cp, cp.callback);
+	assert(p.CanWriteToPacket(encoded.size()));
+	p.Send_bytes(encoded);
+}
 
-	size_t callback = FindCallbackIndex(cp.callback);
-	if (callback > UINT8_MAX || _cmd_dispatch[cp.cmd].Unpack[callback] == nullptr) {
+/**
+ * Encode a command for sending it over the network, in the way
+ * #NetworkGameSocketHandler::ReceiveCommand reads it.
+ * @param cp The command to encode.
+ * @param callback The callback to send along with the command.
+ * @return The encoded command.
+ */
+std::vector<uint8_t> NetworkEncodeCommand(const CommandPacket &cp, CommandCallback *callback)
+{
+	size_t callback_index = FindCallbackIndex(callback);
+	if (callback_index > UINT8_MAX || _cmd_dispatch[cp.cmd].Unpack[callback_index] == nullptr) {
 		Debug(net, 0, "Unknown callback for command; no callback sent (command: {})", cp.cmd);
-		callback = 0; // _callback_table[0] == nullptr
+		callback_index = 0; // _callback_table[0] == nullptr
 	}
-	p.Send_uint8 ((uint8_t)callback);
+
+	std::vector<uint8_t> encoded;
+	encoded.reserve(8 + cp.data.size());
+	auto write = [&encoded](uint32_t value, size_t bytes) {
+		for (size_t i = 0; i < bytes; i++) encoded.push_back(GB(value, i * 8, 8));
+	};
+	write(cp.company.base(), 1);
+	write(to_underlying(cp.cmd), 2);
+	write(cp.err_msg, 2);
+	write(static_cast<uint32_t>(cp.data.size()), 2);
+	encoded.insert(encoded.end(), cp.data.begin(), cp.data.end());
+	write(static_cast<uint32_t>(callback_index), 1);
+	return encoded;
 }
 
 /**
@@ -25,6 +25,10 @@
 #include "../company_type.h"
 #include "../string_type.h"
 
+#include <chrono>
+
+struct PacketCounters;
+
 extern ClientID _network_own_client_id;
 extern ClientID _redirect_console_to_client;
 extern uint8_t _network_reconnect;
@@ -44,6 +48,8 @@ void NetworkReboot();
 void NetworkDisconnect(bool close_admins = true);
 void NetworkGameLoop();
 void NetworkBackgroundLoop();
+void NetworkServerWaitForIO(std::chrono::steady_clock::duration timeout);
+PacketCounters NetworkGetPacketCountersOfTick();
 std::string_view ParseFullConnectionString(std::string_view connection_string, uint16_t &port, CompanyID *company_id = nullptr);
 using NetworkCompanyStatsArray = TypedIndexContainer<std::array<NetworkCompanyStats, MAX_COMPANIES>, CompanyID>; ///< Container with statistics for all possible companies.
 NetworkCompanyStatsArray NetworkGetCompanyStats();
@@ -2081,6 +2081,8 @@ NetworkJoinStatus _network_join_status; ///< The status of joining.
 uint8_t _network_join_waiting;            ///< The number of clients waiting in front of us.
 uint32_t _network_join_bytes;             ///< The number of bytes we already downloaded.
 uint32_t _network_join_bytes_total;       ///< The total number of bytes to download.
+uint32_t _network_join_frames;            ///< The number of frames we already caught up.
+uint32_t _network_join_frames_total;      ///< The total number of frames to catch up.
 
 /** Window showing the progress during joining. */
 struct NetworkJoinStatusWindow : Window {
@@ -2112,6 +2114,9 @@ struct NetworkJoinStatusWindow : Window {
 					case NetworkJoinStatus::Waiting:
 						progress = 15; // third stage is 15%
 						break;
+					case NetworkJoinStatus::CatchingUp:
+						progress = _network_join_frames_total == 0 ? 0 : static_cast<uint8_t>(static_cast<uint64_t>(_network_join_frames) * 100 / _network_join_frames_total);
+						break;
 					case NetworkJoinStatus::Downloading:
 						if (_network_join_bytes_total == 0) {
 							progress = 15; // We don't have the final size yet; the server is still compressing!
@@ -2142,6 +2147,10 @@ struct NetworkJoinStatusWindow : Window {
 						}
 						break;
 
+					case NetworkJoinStatus::CatchingUp:
+						DrawStringMultiLine(r, GetString(STR_NETWORK_CONNECTING_CATCHING_UP, _network_join_frames, _network_join_frames_total), TC_FROMSTRING, SA_CENTER);
+						break;
+
 					default:
 						break;
 				}
@@ -2169,6 +2178,7 @@ struct NetworkJoinStatusWindow : Window {
 				uint64_t max_digits = GetParamMaxDigits(8);
 				size = maxdim(size, GetStringBoundingBox(GetString(STR_NETWORK_CONNECTING_DOWNLOADING_1, max_digits, max_digits)));
 				size = maxdim(size, GetStringBoundingBox(GetString(STR_NETWORK_CONNECTING_DOWNLOADING_1, max_digits, max_digits)));
+				size = maxdim(size, GetStringBoundingBox(GetString(STR_NETWORK_CONNECTING_CATCHING_UP, max_digits, max_digits)));
 				break;
 			}
 		}
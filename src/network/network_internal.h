@@ -48,6 +48,7 @@ enum class NetworkJoinStatus : uint8_t {
 	Downloading, ///< Downloading the map from the server.
 	Processing, ///< Loading the savegame.
 	Registering, ///< Creating a new company.
+	CatchingUp, ///< Running the frames the server ran while we were joining.
 
 	End, ///< Sentinel for end-of-enumeration.
 };
@@ -72,6 +73,8 @@ extern NetworkJoinStatus _network_join_status;
 extern uint8_t _network_join_waiting;
 extern uint32_t _network_join_bytes;
 extern uint32_t _network_join_bytes_total;
+extern uint32_t _network_join_frames;
+extern uint32_t _network_join_frames_total;
 extern ConnectionType _network_server_connection_type;
 extern std::string _network_server_invite_code;
 
@@ -100,13 +103,17 @@ struct CommandPacket {
 	StringID err_msg{}; ///< string ID of error message to use.
 	CommandCallback *callback = nullptr; ///< any callback function executed upon successful completion of the command.
 	CommandDataBuffer data{}; ///< command parameters.
+
+	std::shared_ptr<const std::vector<uint8_t>> encoded{}; ///< The command encoded for clients without callback, shared by the clients it is sent to.
 };
 
 void NetworkDistributeCommands();
 void NetworkExecuteLocalCommandQueue();
+void NetworkExecuteReplayCommand(const CommandPacket &cp);
 void NetworkFreeLocalCommandQueue();
-void NetworkSyncCommandQueue(NetworkClientSocket *cs);
+void NetworkSyncCommandQueue(CommandQueue &queue);
 void NetworkReplaceCommandClientId(CommandPacket &cp, ClientID client_id);
+std::vector<uint8_t> NetworkEncodeCommand(const CommandPacket &cp, CommandCallback *callback);
 
 void ShowNetworkError(StringID error_string);
 void NetworkTextMessage(NetworkAction action, TextColour colour, bool self_send, std::string_view name, std::string_view str = {}, StringParameter &&data = {});
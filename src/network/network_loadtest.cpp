@@ -0,0 +1,682 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file network_loadtest.cpp Simulated clients to put load on a local server. */
+
+#include "../stdafx.h"
+#include "../debug.h"
+#include "../command_func.h"
+#include "../company_cmd.h"
+#include "../console_func.h"
+#include "../rev.h"
+#include "../settings_type.h"
+#include "../signs_cmd.h"
+#include "../terraform_cmd.h"
+#include "../core/random_func.hpp"
+#include "../timer/timer_game_tick.h"
+#include "core/network_game_info.h"
+#include "network.h"
+#include "network_server.h"
+#include "network_loadtest.h"
+
+#include "../safeguards.h"
+
+std::vector<std::unique_ptr<LoadTestNetworkGameSocketHandler>> LoadTestNetworkGameSocketHandler::clients = {};
+
+/** Settings and counters shared by all simulated clients. */
+struct LoadTestState {
+	uint generation = 0; ///< Increased on every stop, so connections of an earlier run can be recognised.
+	uint commands_per_minute = 0; ///< The number of commands each client sends per minute.
+	bool in_process = false; ///< Whether the server is in this process, so its view of the clients can be shown.
+	uint connecting = 0; ///< The number of connections still being made.
+	uint failed = 0; ///< The number of connections that could not be made.
+	uint closed = 0; ///< The number of clients whose connection got closed.
+
+	/* Counters of clients that are gone, so the totals do not drop when a client leaves. */
+	uint64_t bytes_sent = 0; ///< Bytes sent by clients that are gone.
+	uint64_t bytes_received = 0; ///< Bytes received by clients that are gone.
+	uint64_t map_bytes = 0; ///< Map bytes received by clients that are gone.
+	uint64_t commands_sent = 0; ///< Commands sent by clients that are gone.
+
+	std::vector<std::chrono::milliseconds> join_times{}; ///< How long each client took from connecting until it had the map.
+
+	/* The totals at the previous status report, to determine the rates since then. */
+	std::chrono::steady_clock::time_point last_status{}; ///< When the previous status was printed.
+	uint64_t last_bytes_sent = 0; ///< Total bytes sent at the previous status.
+	uint64_t last_bytes_received = 0; ///< Total bytes received at the previous status.
+	uint64_t last_commands_sent = 0; ///< Total commands sent at the previous status.
+	uint32_t last_frame_server = 0; ///< Highest server frame seen at the previous status.
+};
+
+static LoadTestState _load_test; ///< The state of the simulated clients.
+
+/** Connecter for a single simulated client. */
+class TCPLoadTestConnecter : public TCPConnecter {
+private:
+	uint generation; ///< The run this connecter belongs to.
+	bool join_company; ///< Whether the client should start a new company.
+
+public:
+	/**
+	 * Create the connecter.
+	 * @param connection_string The address to connect to.
+	 * @param join_company Whether the client should start a new company.
+	 */
+	TCPLoadTestConnecter(std::string_view connection_string, bool join_company) : TCPConnecter(connection_string, NETWORK_DEFAULT_PORT), generation(_load_test.generation), join_company(join_company) {}
+
+	void OnFailure() override
+	{
+		if (this->generation != _load_test.generation) return;
+
+		Debug(net, 1, "Load test: could not connect to the server");
+		_load_test.connecting--;
+		_load_test.failed++;
+	}
+
+	void OnConnect(SOCKET s) override
+	{
+		if (this->generation != _load_test.generation) {
+			closesocket(s);
+			return;
+		}
+
+		_load_test.connecting--;
+		LoadTestNetworkGameSocketHandler::Connected(s, this->join_company);
+	}
+};
+
+/** Replies to the password request with the password of the server in this process, if any. */
+class LoadTestPasswordRequestHandler : public NetworkAuthenticationPasswordRequestHandler {
+private:
+	LoadTestNetworkGameSocketHandler *client; ///< The client that is authenticating.
+
+public:
+	/**
+	 * Create the handler.
+	 * @param client The client that is authenticating.
+	 */
+	LoadTestPasswordRequestHandler(LoadTestNetworkGameSocketHandler *client) : client(client) {}
+
+	void SendResponse() override { this->client->SendAuthResponse(); }
+	void AskUserForPassword(std::shared_ptr<NetworkAuthenticationPasswordRequest> request) override
+	{
+		request->Reply(_settings_client.network.server_password);
+	}
+};
+
+/**
+ * Create a simulated client on an open socket.
+ * @param s The socket to the server.
+ * @param join_company Whether to start a new company after joining.
+ */
+LoadTestNetworkGameSocketHandler::LoadTestNetworkGameSocketHandler(SOCKET s, bool join_company) :
+	NetworkGameSocketHandler(s), join_company(join_company), playas(join_company ? COMPANY_NEW_COMPANY : COMPANY_SPECTATOR), join_start(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * Start a simulated client on a socket that just got connected.
+ * @param s The socket to the server.
+ * @param join_company Whether to start a new company after joining.
+ */
+/* static */ void LoadTestNetworkGameSocketHandler::Connected(SOCKET s, bool join_company)
+{
+	auto client = std::make_unique<LoadTestNetworkGameSocketHandler>(s, join_company);
+	client->SendJoin();
+
+	LoadTestNetworkGameSocketHandler::clients.push_back(std::move(client));
+}
+
+void LoadTestNetworkGameSocketHandler::SendPacket(std::unique_ptr<Packet> &&packet)
+{
+	this->bytes_sent += packet->Size();
+	this->NetworkGameSocketHandler::SendPacket(std::move(packet));
+}
+
+std::unique_ptr<Packet> LoadTestNetworkGameSocketHandler::ReceivePacket()
+{
+	std::unique_ptr<Packet> p = this->NetworkGameSocketHandler::ReceivePacket();
+	if (p != nullptr) this->bytes_received += p->Size();
+	return p;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::CloseConnection(NetworkRecvStatus status)
+{
+	assert(status != NETWORK_RECV_STATUS_OKAY);
+
+	if (!this->closed) Debug(net, 1, "Load test: client {} lost its connection: status={}", this->client_id, status);
+	this->closed = true;
+	return status;
+}
+
+/**
+ * Check the connection's state, i.e. is the connection still up?
+ * @return \c true if the connection remains valid, otherwise it will be closed.
+ */
+bool LoadTestNetworkGameSocketHandler::CheckConnection()
+{
+	if (this->closed) return false;
+
+	std::chrono::steady_clock::duration lag = std::chrono::steady_clock::now() - this->last_packet;
+
+	/* The server sends a frame every tick, so silence means it is gone. */
+	if (lag > std::chrono::seconds(30)) {
+		this->CloseConnection(NETWORK_RECV_STATUS_CONNECTION_LOST);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Check whether we received/can send some data from/to the server and
+ * when that's the case handle it appropriately.
+ * @return true when everything went okay.
+ */
+bool LoadTestNetworkGameSocketHandler::Receive()
+{
+	if (this->CanSendReceive()) {
+		NetworkRecvStatus res = this->ReceivePackets();
+		if (res != NETWORK_RECV_STATUS_OKAY) {
+			this->CloseConnection(res);
+			return false;
+		}
+	}
+	return !this->closed;
+}
+
+/** Send a command when it is time, and send the packets of this socket handler. */
+void LoadTestNetworkGameSocketHandler::Send()
+{
+	if (this->state == State::Active && _load_test.commands_per_minute != 0) {
+		auto now = std::chrono::steady_clock::now();
+		if (now >= this->next_command) {
+			if (this->next_command != std::chrono::steady_clock::time_point{}) this->SendRandomCommand();
+
+			/* Spread the commands randomly around the requested rate, so the clients do not send in lockstep. */
+			std::chrono::milliseconds interval{60000 / _load_test.commands_per_minute};
+			this->next_command = now + interval / 2 + std::chrono::milliseconds{InteractiveRandomRange(static_cast<uint32_t>(interval.count()) + 1)};
+		}
+	}
+
+	this->SendPackets();
+}
+
+/** Tell the server we would like to join. */
+void LoadTestNetworkGameSocketHandler::SendJoin()
+{
+	auto p = std::make_unique<Packet>(this, PacketGameType::ClientJoin);
+	p->Send_string(GetNetworkRevisionString());
+	p->Send_uint32(_openttd_newgrf_version);
+	this->SendPacket(std::move(p));
+}
+
+/** Identify ourselves to the server. */
+void LoadTestNetworkGameSocketHandler::SendIdentify()
+{
+	auto p = std::make_unique<Packet>(this, PacketGameType::ClientIdentify);
+	p->Send_string("Load test client");
+	p->Send_uint8(this->playas.base());
+	this->SendPacket(std::move(p));
+}
+
+/** Send the response to the authentication request. */
+void LoadTestNetworkGameSocketHandler::SendAuthResponse()
+{
+	auto p = std::make_unique<Packet>(this, PacketGameType::ClientAuthenticationResponse);
+	this->authentication_handler->SendResponse(*p);
+	this->SendPacket(std::move(p));
+}
+
+/** Acknowledge the last frame of the server, so it does not consider us lagging. */
+void LoadTestNetworkGameSocketHandler::SendAck()
+{
+	auto p = std::make_unique<Packet>(this, PacketGameType::ClientAck);
+	p->Send_uint32(this->frame_server);
+	p->Send_uint8(this->token);
+	this->SendPacket(std::move(p));
+}
+
+/**
+ * Send a random command. Clients in a company place signs and terraform at
+ * random tiles; whether those succeed does not matter, as the server does
+ * the same work for checking them. Spectators may not send those, so they
+ * send a chat message to themselves instead.
+ */
+void LoadTestNetworkGameSocketHandler::SendRandomCommand()
+{
+	/* Tiles outside of the map of the server are rejected by it, so wait for its size from the game info. */
+	if (this->playas.base() < MAX_COMPANIES && this->map_size == 0) return;
+
+	this->commands_sent++;
+
+	if (this->playas.base() >= MAX_COMPANIES) {
+		auto p = std::make_unique<Packet>(this, PacketGameType::ClientChat);
+		p->Send_uint8(to_underlying(NetworkAction::ChatClient));
+		p->Send_uint8(to_underlying(NetworkChatDestinationType::Client));
+		p->Send_uint32(this->client_id);
+		p->Send_string(fmt::format("Load test message {}", this->commands_sent));
+		p->Send_uint64(0);
+		this->SendPacket(std::move(p));
+		return;
+	}
+
+	TileIndex tile{InteractiveRandomRange(this->map_size)};
+
+	CommandPacket cp;
+	cp.company = this->playas;
+	if (InteractiveRandomRange(2) == 0) {
+		cp.cmd = Commands::PlaceSign;
+		cp.data = EndianBufferWriter<CommandDataBuffer>::FromValue(CommandTraits<Commands::PlaceSign>::Args{tile, fmt::format("Load test {}", this->client_id)});
+	} else {
+		static const Slope corners[] = { SLOPE_N, SLOPE_E, SLOPE_S, SLOPE_W };
+		cp.cmd = Commands::TerraformLand;
+		cp.data = EndianBufferWriter<CommandDataBuffer>::FromValue(CommandTraits<Commands::TerraformLand>::Args{tile, corners[InteractiveRandomRange(static_cast<uint32_t>(std::size(corners)))], InteractiveRandomRange(2) == 0});
+	}
+
+	auto p = std::make_unique<Packet>(this, PacketGameType::ClientCommand);
+	this->NetworkGameSocketHandler::SendCommand(*p, cp);
+	this->SendPacket(std::move(p));
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerFull(Packet &)
+{
+	Debug(net, 1, "Load test: server is full");
+	return NETWORK_RECV_STATUS_SERVER_FULL;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerGameInfo(Packet &p)
+{
+	NetworkGameInfo info{};
+	DeserializeNetworkGameInfo(p, info);
+	this->map_size = info.map_width * info.map_height;
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerBanned(Packet &)
+{
+	Debug(net, 1, "Load test: banned by the server");
+	return NETWORK_RECV_STATUS_SERVER_BANNED;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerError(Packet &p)
+{
+	NetworkErrorCode error = static_cast<NetworkErrorCode>(p.Recv_uint8());
+	Debug(net, 1, "Load test: client {} got error {} from the server", this->client_id, error);
+	return NETWORK_RECV_STATUS_SERVER_ERROR;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerClientInfo(Packet &p)
+{
+	ClientID client_id = static_cast<ClientID>(p.Recv_uint32());
+	CompanyID playas = static_cast<CompanyID>(p.Recv_uint8());
+
+	/* The server tells us about our company, e.g. once the new company got started. */
+	if (client_id == this->client_id) this->playas = playas;
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerAuthenticationRequest(Packet &p)
+{
+	if (this->state != State::Join) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	if (this->authentication_handler == nullptr) {
+		this->authentication_handler = NetworkAuthenticationClientHandler::Create(std::make_shared<LoadTestPasswordRequestHandler>(this),
+				_settings_client.network.client_secret_key, _settings_client.network.client_public_key);
+	}
+	switch (this->authentication_handler->ReceiveRequest(p)) {
+		case NetworkAuthenticationClientHandler::RequestResult::ReadyForResponse:
+			this->SendAuthResponse();
+			return NETWORK_RECV_STATUS_OKAY;
+
+		case NetworkAuthenticationClientHandler::RequestResult::AwaitUserInput:
+			return NETWORK_RECV_STATUS_OKAY;
+
+		case NetworkAuthenticationClientHandler::RequestResult::Invalid:
+		default:
+			return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+	}
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerEnableEncryption(Packet &p)
+{
+	if (this->state != State::Join || this->authentication_handler == nullptr) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	if (!this->authentication_handler->ReceiveEnableEncryption(p)) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	this->receive_encryption_handler = this->authentication_handler->CreateServerToClientEncryptionHandler();
+	this->send_encryption_handler = this->authentication_handler->CreateClientToServerEncryptionHandler();
+	this->authentication_handler = nullptr;
+
+	this->SendIdentify();
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerCheckNewGRFs(Packet &)
+{
+	/* The map is never loaded, so whether we have the NewGRFs does not matter. */
+	this->SendPacket(std::make_unique<Packet>(this, PacketGameType::ClientNewGRFsChecked));
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerWelcome(Packet &p)
+{
+	if (this->state != State::Join) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	this->client_id = static_cast<ClientID>(p.Recv_uint32());
+	this->state = State::Map;
+
+	Debug(net, 6, "Load test: client {} is welcome", this->client_id);
+
+	/* The map itself is thrown away, so get its size from the game info of the server. */
+	this->SendPacket(std::make_unique<Packet>(this, PacketGameType::ClientGameInfo));
+	this->SendPacket(std::make_unique<Packet>(this, PacketGameType::ClientGetMap));
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerWaitForMap(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerMapBegin(Packet &p)
+{
+	if (this->state != State::Map) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	this->frame_server = p.Recv_uint32();
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerMapSize(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerMapData(Packet &p)
+{
+	if (this->state != State::Map) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	/* Only the amount matters; the map itself is thrown away. */
+	this->map_bytes += p.Size();
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerMapDone(Packet &)
+{
+	if (this->state != State::Map) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	this->state = State::Active;
+	_load_test.join_times.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->join_start));
+
+	Debug(net, 6, "Load test: client {} received the map", this->client_id);
+
+	this->SendPacket(std::make_unique<Packet>(this, PacketGameType::ClientMapOk));
+
+	if (this->join_company) {
+		CommandPacket cp;
+		cp.company = COMPANY_SPECTATOR;
+		cp.cmd = Commands::CompanyControl;
+		cp.data = EndianBufferWriter<CommandDataBuffer>::FromValue(CommandTraits<Commands::CompanyControl>::Args{CompanyCtrlAction::New, CompanyID::Invalid(), CompanyRemoveReason::None, this->client_id});
+
+		auto p = std::make_unique<Packet>(this, PacketGameType::ClientCommand);
+		this->NetworkGameSocketHandler::SendCommand(*p, cp);
+		this->SendPacket(std::move(p));
+	}
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerClientJoined(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerFrame(Packet &p)
+{
+	if (this->state != State::Active) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+
+	this->frame_server = p.Recv_uint32();
+	p.Recv_uint32(); // The frame the server allows us to run to.
+#ifdef ENABLE_NETWORK_SYNC_EVERY_FRAME
+#ifdef NETWORK_SEND_DOUBLE_SEED
+	if (p.CanReadFromPacket(sizeof(uint32_t) + sizeof(uint32_t))) {
+		p.Recv_uint32();
+		p.Recv_uint32();
+	}
+#else
+	if (p.CanReadFromPacket(sizeof(uint32_t))) p.Recv_uint32();
+#endif
+#endif
+	if (p.CanReadFromPacket(sizeof(uint8_t))) this->token = p.Recv_uint8();
+
+	/* Like real clients, acknowledge once a day. The first one finishes joining. */
+	if (this->frame_server >= this->next_ack_frame) {
+		this->next_ack_frame = this->frame_server + Ticks::DAY_TICKS;
+		this->SendAck();
+	}
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerSync(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerCommand(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerCommandBatch(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerChat(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerExternalChat(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerQuit(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerErrorQuit(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerShutdown(Packet &)
+{
+	return NETWORK_RECV_STATUS_CLIENT_QUIT;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerNewGame(Packet &)
+{
+	/* A real client would reconnect, but the load test is over when the game is. */
+	return NETWORK_RECV_STATUS_CLIENT_QUIT;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerRemoteConsoleCommand(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerMove(Packet &p)
+{
+	ClientID client_id = static_cast<ClientID>(p.Recv_uint32());
+	CompanyID company_id = static_cast<CompanyID>(p.Recv_uint8());
+
+	if (client_id == this->client_id) this->playas = company_id;
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+NetworkRecvStatus LoadTestNetworkGameSocketHandler::ReceiveServerConfigurationUpdate(Packet &)
+{
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+/**
+ * Let all simulated clients send and receive, and remove the ones whose connection got closed.
+ */
+/* static */ void LoadTestNetworkGameSocketHandler::SendReceive()
+{
+	auto &clients = LoadTestNetworkGameSocketHandler::clients;
+	for (auto it = clients.begin(); it != clients.end(); /* nothing */) {
+		LoadTestNetworkGameSocketHandler *client = it->get();
+		if (client->Receive() && client->CheckConnection()) {
+			it++;
+			continue;
+		}
+
+		_load_test.closed++;
+		_load_test.bytes_sent += client->bytes_sent;
+		_load_test.bytes_received += client->bytes_received;
+		_load_test.map_bytes += client->map_bytes;
+		_load_test.commands_sent += client->commands_sent;
+		it = clients.erase(it);
+	}
+
+	for (auto &client : clients) {
+		client->Send();
+	}
+}
+
+/**
+ * Let all simulated clients leave the server.
+ */
+/* static */ void LoadTestNetworkGameSocketHandler::CloseAll()
+{
+	for (auto &client : LoadTestNetworkGameSocketHandler::clients) {
+		if (client->state == State::Active) client->SendPacket(std::make_unique<Packet>(client.get(), PacketGameType::ClientQuit));
+		client->SendPackets(true);
+	}
+	LoadTestNetworkGameSocketHandler::clients.clear();
+}
+
+/**
+ * Print the state of the simulated clients, the traffic since the previous
+ * report and, when the server runs in this process, how far behind the
+ * server thinks the clients are.
+ */
+/* static */ void LoadTestNetworkGameSocketHandler::PrintStatus()
+{
+	uint joining = 0;
+	uint downloading = 0;
+	uint active = 0;
+	uint64_t bytes_sent = _load_test.bytes_sent;
+	uint64_t bytes_received = _load_test.bytes_received;
+	uint64_t map_bytes = _load_test.map_bytes;
+	uint64_t commands_sent = _load_test.commands_sent;
+	uint32_t frame_server = _load_test.last_frame_server;
+	uint lag_count = 0;
+	uint lag_total = 0;
+	uint lag_max = 0;
+
+	for (const auto &client : LoadTestNetworkGameSocketHandler::clients) {
+		switch (client->state) {
+			case State::Join: joining++; break;
+			case State::Map: downloading++; break;
+			case State::Active: active++; break;
+		}
+		bytes_sent += client->bytes_sent;
+		bytes_received += client->bytes_received;
+		map_bytes += client->map_bytes;
+		commands_sent += client->commands_sent;
+		if (client->state == State::Active) frame_server = std::max(frame_server, client->frame_server);
+
+		if (_load_test.in_process && _network_server && client->client_id != INVALID_CLIENT_ID) {
+			const NetworkClientSocket *cs = NetworkClientSocket::GetByClientID(client->client_id);
+			if (cs == nullptr) continue;
+
+			uint lag = NetworkCalculateLag(cs);
+			lag_count++;
+			lag_total += lag;
+			lag_max = std::max(lag_max, lag);
+		}
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(now - _load_test.last_status).count();
+	if (seconds <= 0) seconds = 1;
+
+	IConsolePrint(CC_INFO, "Load test clients: {} connecting, {} joining, {} downloading the map, {} active, {} failed to connect, {} disconnected.",
+			_load_test.connecting, joining, downloading, active, _load_test.failed, _load_test.closed);
+
+	if (!_load_test.join_times.empty()) {
+		std::chrono::milliseconds total{0};
+		std::chrono::milliseconds slowest{0};
+		for (const auto &join_time : _load_test.join_times) {
+			total += join_time;
+			slowest = std::max(slowest, join_time);
+		}
+		IConsolePrint(CC_INFO, "Joining took {} ms on average and {} ms at most, for {} clients.",
+				total.count() / static_cast<int64_t>(_load_test.join_times.size()), slowest.count(), _load_test.join_times.size());
+	}
+
+	IConsolePrint(CC_INFO, "Received {} KiB (of which {} KiB map) and sent {} KiB in total.", bytes_received / 1024, map_bytes / 1024, bytes_sent / 1024);
+	IConsolePrint(CC_INFO, "Since the previous status: {:.1f} KiB/s received, {:.1f} KiB/s sent, {:.1f} commands/s, {:.1f} server frames/s.",
+			(bytes_received - _load_test.last_bytes_received) / 1024.0 / seconds, (bytes_sent - _load_test.last_bytes_sent) / 1024.0 / seconds,
+			(commands_sent - _load_test.last_commands_sent) / seconds, (frame_server - _load_test.last_frame_server) / seconds);
+
+	if (lag_count != 0) {
+		IConsolePrint(CC_INFO, "Lag of the clients according to the server: {} ticks on average, {} ticks at most.", lag_total / lag_count, lag_max);
+	}
+
+	_load_test.last_status = now;
+	_load_test.last_bytes_sent = bytes_sent;
+	_load_test.last_bytes_received = bytes_received;
+	_load_test.last_commands_sent = commands_sent;
+	_load_test.last_frame_server = frame_server;
+}
+
+/**
+ * Start simulated clients that connect to a server on this machine.
+ * @param count The number of clients to start.
+ * @param companies The number of those clients that start a new company.
+ * @param commands_per_minute The number of commands each client sends per minute.
+ * @param port The port of the server; it is always reached via the loopback address.
+ * @return Whether the clients are being started.
+ */
+bool NetworkLoadTestStart(uint count, uint companies, uint commands_per_minute, uint16_t port)
+{
+	/* A client in this process would drop back to the main menu when any of the simulated clients loses its connection. */
+	if (_networking && !_network_server) {
+		IConsolePrint(CC_ERROR, "Simulated clients cannot be started while being connected to a server as client.");
+		return false;
+	}
+
+	if (_load_test.last_status == std::chrono::steady_clock::time_point{}) _load_test.last_status = std::chrono::steady_clock::now();
+	_load_test.commands_per_minute = commands_per_minute;
+	_load_test.in_process = _network_server && port == _settings_client.network.server_port;
+
+	std::string connection_string = fmt::format("127.0.0.1:{}", port);
+	for (uint i = 0; i < count; i++) {
+		_load_test.connecting++;
+		TCPConnecter::Create<TCPLoadTestConnecter>(connection_string, i < companies);
+	}
+	return true;
+}
+
+/**
+ * Stop all simulated clients, and forget about their statistics.
+ */
+void NetworkLoadTestStop()
+{
+	LoadTestNetworkGameSocketHandler::CloseAll();
+
+	uint generation = _load_test.generation + 1;
+	_load_test = {};
+	_load_test.generation = generation;
+}
@@ -0,0 +1,106 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file network_loadtest.h Simulated clients to put load on a local server. */
+
+#ifndef NETWORK_LOADTEST_H
+#define NETWORK_LOADTEST_H
+
+#include "network_internal.h"
+
+/**
+ * Class for a simulated client. It goes through joining and downloading the
+ * map like a real client, but it throws the map away and does not run the
+ * game; it only acknowledges the frames of the server and sends commands at
+ * random. That way many of them can run in one process.
+ */
+class LoadTestNetworkGameSocketHandler : public NetworkGameSocketHandler {
+private:
+	/** The states a simulated client goes through. */
+	enum class State : uint8_t {
+		Join, ///< Authenticating and identifying.
+		Map, ///< Waiting for, or downloading, the map.
+		Active, ///< Acknowledging frames and sending commands.
+	};
+
+	static std::vector<std::unique_ptr<LoadTestNetworkGameSocketHandler>> clients; ///< The simulated clients.
+
+	std::unique_ptr<class NetworkAuthenticationClientHandler> authentication_handler = nullptr; ///< The handler for the authentication.
+	State state = State::Join; ///< What the client is doing.
+	bool closed = false; ///< Whether the connection got closed.
+	bool join_company; ///< Whether to start a new company after joining.
+	CompanyID playas; ///< The company the server says we play as.
+	uint32_t frame_server = 0; ///< The last frame the server told us about.
+	uint32_t next_ack_frame = 0; ///< The frame after which to acknowledge again.
+	uint8_t token = 0; ///< The token to send back with the next acknowledgement.
+	uint32_t map_size = 0; ///< The number of tiles of the map of the server, from its game info.
+	std::chrono::steady_clock::time_point join_start; ///< When we connected.
+	std::chrono::steady_clock::time_point next_command{}; ///< When to send the next command.
+
+	uint64_t bytes_sent = 0; ///< Number of bytes of packets sent.
+	uint64_t bytes_received = 0; ///< Number of bytes of packets received.
+	uint64_t map_bytes = 0; ///< Number of bytes of the map received.
+	uint32_t commands_sent = 0; ///< Number of commands (and chat messages) sent.
+
+protected:
+	NetworkRecvStatus ReceiveServerFull(Packet &p) override;
+	NetworkRecvStatus ReceiveServerBanned(Packet &p) override;
+	NetworkRecvStatus ReceiveServerGameInfo(Packet &p) override;
+	NetworkRecvStatus ReceiveServerError(Packet &p) override;
+	NetworkRecvStatus ReceiveServerClientInfo(Packet &p) override;
+	NetworkRecvStatus ReceiveServerAuthenticationRequest(Packet &p) override;
+	NetworkRecvStatus ReceiveServerEnableEncryption(Packet &p) override;
+	NetworkRecvStatus ReceiveServerCheckNewGRFs(Packet &p) override;
+	NetworkRecvStatus ReceiveServerWelcome(Packet &p) override;
+	NetworkRecvStatus ReceiveServerWaitForMap(Packet &p) override;
+	NetworkRecvStatus ReceiveServerMapBegin(Packet &p) override;
+	NetworkRecvStatus ReceiveServerMapSize(Packet &p) override;
+	NetworkRecvStatus ReceiveServerMapData(Packet &p) override;
+	NetworkRecvStatus ReceiveServerMapDone(Packet &p) override;
+	NetworkRecvStatus ReceiveServerClientJoined(Packet &p) override;
+	NetworkRecvStatus ReceiveServerFrame(Packet &p) override;
+	NetworkRecvStatus ReceiveServerSync(Packet &p) override;
+	NetworkRecvStatus ReceiveServerCommand(Packet &p) override;
+	NetworkRecvStatus ReceiveServerCommandBatch(Packet &p) override;
+	NetworkRecvStatus ReceiveServerChat(Packet &p) override;
+	NetworkRecvStatus ReceiveServerExternalChat(Packet &p) override;
+	NetworkRecvStatus ReceiveServerQuit(Packet &p) override;
+	NetworkRecvStatus ReceiveServerErrorQuit(Packet &p) override;
+	NetworkRecvStatus ReceiveServerShutdown(Packet &p) override;
+	NetworkRecvStatus ReceiveServerNewGame(Packet &p) override;
+	NetworkRecvStatus ReceiveServerRemoteConsoleCommand(Packet &p) override;
+	NetworkRecvStatus ReceiveServerMove(Packet &p) override;
+	NetworkRecvStatus ReceiveServerConfigurationUpdate(Packet &p) override;
+
+	void SendJoin();
+	void SendIdentify();
+	void SendAck();
+	void SendRandomCommand();
+
+	bool CheckConnection();
+	bool Receive();
+	void Send();
+
+public:
+	LoadTestNetworkGameSocketHandler(SOCKET s, bool join_company);
+
+	void SendAuthResponse();
+
+	void SendPacket(std::unique_ptr<Packet> &&packet) override;
+	std::unique_ptr<Packet> ReceivePacket() override;
+	NetworkRecvStatus CloseConnection(NetworkRecvStatus status) override;
+
+	static void Connected(SOCKET s, bool join_company);
+	static void SendReceive();
+	static void CloseAll();
+	static void PrintStatus();
+};
+
+bool NetworkLoadTestStart(uint count, uint companies, uint commands_per_minute, uint16_t port);
+void NetworkLoadTestStop();
+
+#endif /* NETWORK_LOADTEST_H */
@@ -0,0 +1,444 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/**
+ * @file network_replay.cpp Recording the game of a server, and replaying it.
+ *
+ * A replay starts with a savegame of the moment the recording started,
+ * followed by records of every command the server executed and the state
+ * of the game after every tick. Replaying loads the savegame, and then
+ * executes the commands and ticks as fast as possible, checking the state
+ * after every tick. The first tick where it differs is the tick where the
+ * replay desynced from the original game. The state consists of the state
+ * of the random generator and a hash of the companies' money and the
+ * positions and speeds of the vehicles, which catches desyncs that do not
+ * (yet) involve the random generator.
+ *
+ * All values are little endian. The file starts with:
+ *  - 4 bytes "OTTR";
+ *  - uint16_t version of the replay format;
+ *  - uint16_t length and the revision of the game that recorded the replay;
+ *  - uint64_t size of the savegame, followed by the savegame itself.
+ * After that, until the end of the file, records of a uint8_t #ReplayRecordType and:
+ *  - #ReplayRecordType::Command: uint32_t tick the command is executed in,
+ *    uint16_t length and the command as encoded by #NetworkEncodeCommand;
+ *  - #ReplayRecordType::Tick: uint32_t number of the tick, two uint32_t
+ *    of the state of the random generator and the uint32_t state hash after the tick;
+ *  - #ReplayRecordType::End: nothing; the recording was stopped.
+ * Ticks are counted from the start of the recording, the first tick being 1.
+ */
+
+#include "../stdafx.h"
+#include "../debug.h"
+#include "../openttd.h"
+#include "../command_func.h"
+#include "../company_base.h"
+#include "../company_func.h"
+#include "../console_func.h"
+#include "../fileio_func.h"
+#include "../rev.h"
+#include "../vehicle_base.h"
+#include "../core/random_func.hpp"
+#include "../saveload/saveload.h"
+#include "../saveload/saveload_error.hpp"
+#include "../saveload/saveload_filter.h"
+#include "network_func.h"
+#include "network_internal.h"
+#include "network_replay.h"
+
+#include "table/strings.h"
+
+#include "../safeguards.h"
+
+extern bool SafeLoad(const std::string &filename, SaveLoadOperation fop, DetailedFileType dft, GameMode newgm, Subdirectory subdir, std::shared_ptr<LoadFilter> lf);
+
+/** Whether a replay is being played; scripts do not run and the game does not post commands then. */
+bool _network_replaying = false;
+
+/** The bytes a replay file starts with. */
+static const std::array<uint8_t, 4> REPLAY_MAGIC = {'O', 'T', 'T', 'R'};
+/** Version of the replay format. */
+static const uint16_t REPLAY_VERSION = 2;
+
+/** Types of records in a replay. */
+enum class ReplayRecordType : uint8_t {
+	End, ///< End of the replay.
+	Command, ///< A command that is executed.
+	Tick, ///< A tick that has been run.
+};
+
+static std::optional<FileHandle> _replay_file; ///< The file the replay is being recorded to.
+static uint32_t _replay_tick = 0; ///< Number of ticks that have been recorded.
+
+/** Writes the savegame at the start of a replay to the replay file. */
+struct ReplaySaveFilter : SaveFilter {
+	FILE *file; ///< The replay file.
+
+	/**
+	 * Create the filter.
+	 * @param file The replay file.
+	 */
+	ReplaySaveFilter(FILE *file) : SaveFilter(nullptr), file(file)
+	{
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		if (fwrite(buf, 1, size, this->file) != size) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+	}
+
+	void Finish() override
+	{
+	}
+};
+
+/** Reads the savegame at the start of a replay from the replay file. */
+struct ReplayLoadFilter : LoadFilter {
+	FILE *file; ///< The replay file.
+	long begin; ///< Offset of the savegame in the file.
+	size_t size; ///< Size of the savegame.
+	size_t read = 0; ///< Number of bytes of the savegame read so far.
+
+	/**
+	 * Create the filter, reading the savegame from the current position of the file.
+	 * @param file The replay file.
+	 * @param size Size of the savegame.
+	 */
+	ReplayLoadFilter(FILE *file, size_t size) : LoadFilter(nullptr), file(file), begin(ftell(file)), size(size)
+	{
+	}
+
+	size_t Read(uint8_t *buf, size_t len) override
+	{
+		len = std::min(len, this->size - this->read);
+		size_t n = fread(buf, 1, len, this->file);
+		this->read += n;
+		return n;
+	}
+
+	void Reset() override
+	{
+		fseek(this->file, this->begin, SEEK_SET);
+		this->read = 0;
+	}
+};
+
+/**
+ * Write a little endian value to the replay file.
+ * @param file The file to write to.
+ * @param value The value to write.
+ * @param bytes Number of bytes of the value to write.
+ * @return Whether the value could be written.
+ */
+static bool WriteReplayValue(FILE *file, uint64_t value, size_t bytes)
+{
+	std::array<uint8_t, 8> buf;
+	for (size_t i = 0; i < bytes; i++) buf[i] = GB(value, i * 8, 8);
+	return fwrite(buf.data(), 1, bytes, file) == bytes;
+}
+
+/**
+ * Read a little endian value from the replay file.
+ * @param file The file to read from.
+ * @param bytes Number of bytes of the value to read.
+ * @return The value, or \c std::nullopt at the end of the file.
+ */
+static std::optional<uint64_t> ReadReplayValue(FILE *file, size_t bytes)
+{
+	std::array<uint8_t, 8> buf;
+	if (fread(buf.data(), 1, bytes, file) != bytes) return std::nullopt;
+
+	uint64_t value = 0;
+	for (size_t i = 0; i < bytes; i++) value |= static_cast<uint64_t>(buf[i]) << (i * 8);
+	return value;
+}
+
+/**
+ * Add a value to a state hash.
+ * @param hash The hash so far.
+ * @param value The value to add.
+ * @return The new hash.
+ */
+static uint32_t HashReplayValue(uint32_t hash, uint64_t value)
+{
+	/* FNV-1a over the two halves of the value. */
+	hash = (hash ^ static_cast<uint32_t>(value)) * 16777619;
+	return (hash ^ static_cast<uint32_t>(value >> 32)) * 16777619;
+}
+
+/**
+ * Calculate a cheap hash of the state of the game, to find desyncs that do not affect the random generator.
+ * @return The hash of the money of the companies and the positions and speeds of the vehicles.
+ */
+static uint32_t GetReplayStateHash()
+{
+	uint32_t hash = 2166136261;
+	for (const Company *c : Company::Iterate()) {
+		hash = HashReplayValue(hash, c->index.base());
+		hash = HashReplayValue(hash, static_cast<int64_t>(c->money));
+	}
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		hash = HashReplayValue(hash, v->index.base());
+		hash = HashReplayValue(hash, static_cast<uint32_t>(v->x_pos) | static_cast<uint64_t>(static_cast<uint32_t>(v->y_pos)) << 32);
+		hash = HashReplayValue(hash, static_cast<uint32_t>(v->z_pos) | static_cast<uint64_t>(v->cur_speed) << 32);
+	}
+	return hash;
+}
+
+/**
+ * Stop the recording after a write to the replay file failed.
+ */
+static void ReplayWriteFailed()
+{
+	Debug(net, 0, "Writing the replay failed; recording stopped");
+	_replay_file.reset();
+}
+
+/**
+ * Start recording a replay, beginning with a savegame of the current game.
+ * @param filename The name of the file in the save directory to record to.
+ * @return Whether the recording was started.
+ */
+bool NetworkReplayStartRecording(const std::string &filename)
+{
+	NetworkReplayStopRecording();
+
+	auto file = FioFOpenFile(filename, "wb", Subdirectory::Save);
+	if (!file.has_value()) return false;
+
+	bool ok = fwrite(REPLAY_MAGIC.data(), 1, REPLAY_MAGIC.size(), *file) == REPLAY_MAGIC.size();
+	ok &= WriteReplayValue(*file, REPLAY_VERSION, sizeof(uint16_t));
+	ok &= WriteReplayValue(*file, _openttd_revision.size(), sizeof(uint16_t));
+	ok &= fwrite(_openttd_revision.data(), 1, _openttd_revision.size(), *file) == _openttd_revision.size();
+
+	/* Reserve room for the size of the savegame, and fill it in once it is known. */
+	long size_offset = ftell(*file);
+	ok &= WriteReplayValue(*file, 0, sizeof(uint64_t));
+	if (!ok) return false;
+
+	/* An autosave may still be running in the background. */
+	WaitTillSaved();
+
+	long begin = ftell(*file);
+	if (SaveWithFilter(std::make_shared<ReplaySaveFilter>(*file), false) != SL_OK) return false;
+	long end = ftell(*file);
+
+	fseek(*file, size_offset, SEEK_SET);
+	ok = WriteReplayValue(*file, end - begin, sizeof(uint64_t));
+	fseek(*file, end, SEEK_SET);
+	if (!ok) return false;
+
+	_replay_file = std::move(file);
+	_replay_tick = 0;
+	return true;
+}
+
+/**
+ * Stop recording a replay, if one is being recorded.
+ */
+void NetworkReplayStopRecording()
+{
+	if (!_replay_file.has_value()) return;
+
+	WriteReplayValue(*_replay_file, to_underlying(ReplayRecordType::End), sizeof(uint8_t));
+	_replay_file.reset();
+}
+
+/**
+ * Check whether a replay is being recorded.
+ * @return \c true when a replay is being recorded.
+ */
+bool NetworkReplayIsRecording()
+{
+	return _replay_file.has_value();
+}
+
+/**
+ * Record a command that is executed in the coming tick.
+ * @param cp The command.
+ */
+void NetworkReplayRecordCommand(const CommandPacket &cp)
+{
+	if (!_replay_file.has_value()) return;
+
+	std::vector<uint8_t> encoded = NetworkEncodeCommand(cp, nullptr);
+
+	bool ok = WriteReplayValue(*_replay_file, to_underlying(ReplayRecordType::Command), sizeof(uint8_t));
+	ok &= WriteReplayValue(*_replay_file, _replay_tick + 1, sizeof(uint32_t));
+	ok &= WriteReplayValue(*_replay_file, encoded.size(), sizeof(uint16_t));
+	ok &= fwrite(encoded.data(), 1, encoded.size(), *_replay_file) == encoded.size();
+	if (!ok) ReplayWriteFailed();
+}
+
+/**
+ * Record that a tick has been run, together with the state of the random generator and the state hash.
+ */
+void NetworkReplayRecordTick()
+{
+	if (!_replay_file.has_value()) return;
+
+	_replay_tick++;
+
+	bool ok = WriteReplayValue(*_replay_file, to_underlying(ReplayRecordType::Tick), sizeof(uint8_t));
+	ok &= WriteReplayValue(*_replay_file, _replay_tick, sizeof(uint32_t));
+	ok &= WriteReplayValue(*_replay_file, _random.state[0], sizeof(uint32_t));
+	ok &= WriteReplayValue(*_replay_file, _random.state[1], sizeof(uint32_t));
+	ok &= WriteReplayValue(*_replay_file, GetReplayStateHash(), sizeof(uint32_t));
+	/* Flush every tick, so a crash of the server leaves a replay up to the crash. */
+	ok &= fflush(*_replay_file) == 0;
+	if (!ok) ReplayWriteFailed();
+}
+
+/**
+ * Decode a command of a replay.
+ * @param encoded The command as encoded by #NetworkEncodeCommand.
+ * @param[out] cp The decoded command.
+ * @return Whether the command is valid.
+ */
+static bool DecodeReplayCommand(std::span<const uint8_t> encoded, CommandPacket &cp)
+{
+	/* Company, command, error message and length of the data. */
+	static const size_t HEADER_SIZE = 1 + 2 + 2 + 2;
+	if (encoded.size() < HEADER_SIZE) return false;
+
+	auto read = [&encoded](size_t pos, size_t bytes) {
+		uint32_t value = 0;
+		for (size_t i = 0; i < bytes; i++) value |= encoded[pos + i] << (i * 8);
+		return value;
+	};
+
+	cp.company = static_cast<CompanyID>(read(0, 1));
+	cp.cmd = static_cast<Commands>(read(1, 2));
+	cp.err_msg = read(3, 2);
+	size_t length = read(5, 2);
+	if (!IsValidCommand(cp.cmd) || encoded.size() < HEADER_SIZE + length) return false;
+
+	cp.data.assign(encoded.begin() + HEADER_SIZE, encoded.begin() + HEADER_SIZE + length);
+	return true;
+}
+
+/**
+ * Play a replay as fast as possible. The game of the replay replaces the
+ * current game, and continues as normal game after the replay ends.
+ * @param filename The name of the replay file in the save directory.
+ * @param max_ticks Stop after this number of ticks.
+ * @return \c true when the replay was played without desyncing.
+ */
+bool NetworkReplayPlay(const std::string &filename, uint32_t max_ticks)
+{
+	auto file = FioFOpenFile(filename, "rb", Subdirectory::Save);
+	if (!file.has_value()) {
+		IConsolePrint(CC_ERROR, "Cannot open replay '{}'.", filename);
+		return false;
+	}
+
+	std::array<uint8_t, 4> magic;
+	bool valid = fread(magic.data(), 1, magic.size(), *file) == magic.size() && magic == REPLAY_MAGIC;
+	std::optional<uint64_t> version = ReadReplayValue(*file, sizeof(uint16_t));
+	std::optional<uint64_t> revision_length = ReadReplayValue(*file, sizeof(uint16_t));
+	if (!valid || version != REPLAY_VERSION || !revision_length.has_value()) {
+		IConsolePrint(CC_ERROR, "'{}' is not a replay of this version of the game.", filename);
+		return false;
+	}
+
+	/* Any other revision may run the game differently, and thus desync even though nothing is wrong. */
+	std::string revision(*revision_length, '\0');
+	std::optional<uint64_t> savegame_size;
+	if (fread(revision.data(), 1, revision.size(), *file) == revision.size()) savegame_size = ReadReplayValue(*file, sizeof(uint64_t));
+	if (!savegame_size.has_value()) {
+		IConsolePrint(CC_ERROR, "'{}' is not a replay of this version of the game.", filename);
+		return false;
+	}
+	if (revision != _openttd_revision) {
+		IConsolePrint(CC_ERROR, "'{}' was recorded with revision '{}', which differs from this revision '{}'.", filename, revision, _openttd_revision);
+		return false;
+	}
+
+	auto reader = std::make_shared<ReplayLoadFilter>(*file, *savegame_size);
+	long records = reader->begin + static_cast<long>(*savegame_size);
+
+	_file_to_saveload.SetMode(FIOS_TYPE_FILE, SaveLoadOperation::Load);
+	if (!SafeLoad({}, SaveLoadOperation::Load, DetailedFileType::GameFile, GM_NORMAL, Subdirectory::None, std::move(reader))) {
+		IConsolePrint(CC_ERROR, "Loading the savegame of replay '{}' failed.", filename);
+		return false;
+	}
+	/* Replays are played on a dedicated server, so continue the game like one. */
+	SetLocalCompany(COMPANY_SPECTATOR);
+	NetworkOnGameStart();
+	fseek(*file, records, SEEK_SET);
+
+	_network_replaying = true;
+	auto start = std::chrono::steady_clock::now();
+
+	uint32_t tick = 0;
+	uint32_t commands = 0;
+	bool in_sync = true;
+	std::vector<uint8_t> encoded;
+	for (;;) {
+		std::optional<uint64_t> type = ReadReplayValue(*file, sizeof(uint8_t));
+		/* Without an end record the server stopped while recording; the replay ends with the file. */
+		if (!type.has_value() || *type == to_underlying(ReplayRecordType::End)) break;
+
+		std::optional<uint64_t> record_tick = ReadReplayValue(*file, sizeof(uint32_t));
+		if (!record_tick.has_value()) break;
+		if (*record_tick != tick + 1) {
+			IConsolePrint(CC_ERROR, "Replay is corrupt at tick {}.", tick);
+			in_sync = false;
+			break;
+		}
+		if (*record_tick > max_ticks) break;
+
+		if (*type == to_underlying(ReplayRecordType::Command)) {
+			std::optional<uint64_t> length = ReadReplayValue(*file, sizeof(uint16_t));
+			encoded.resize(length.value_or(0));
+
+			CommandPacket cp;
+			if (!length.has_value() || fread(encoded.data(), 1, encoded.size(), *file) != encoded.size() || !DecodeReplayCommand(encoded, cp)) {
+				IConsolePrint(CC_ERROR, "Replay contains an invalid command at tick {}.", tick + 1);
+				in_sync = false;
+				break;
+			}
+
+			cp.frame = tick + 1;
+			NetworkExecuteReplayCommand(cp);
+			commands++;
+		} else if (*type == to_underlying(ReplayRecordType::Tick)) {
+			std::optional<uint64_t> state0 = ReadReplayValue(*file, sizeof(uint32_t));
+			std::optional<uint64_t> state1 = ReadReplayValue(*file, sizeof(uint32_t));
+			std::optional<uint64_t> state_hash = ReadReplayValue(*file, sizeof(uint32_t));
+			if (!state_hash.has_value()) break;
+
+			StateGameLoop();
+			tick++;
+
+			if (_random.state[0] != *state0 || _random.state[1] != *state1) {
+				IConsolePrint(CC_ERROR, "Replay desynced at tick {}: expected random state {:08x} {:08x}, got {:08x} {:08x}.",
+						tick, *state0, *state1, _random.state[0], _random.state[1]);
+				in_sync = false;
+				break;
+			}
+			uint32_t hash = GetReplayStateHash();
+			if (hash != *state_hash) {
+				IConsolePrint(CC_ERROR, "Replay desynced at tick {}: expected state hash {:08x}, got {:08x}.", tick, *state_hash, hash);
+				in_sync = false;
+				break;
+			}
+		} else {
+			IConsolePrint(CC_ERROR, "Replay is corrupt at tick {}.", tick);
+			in_sync = false;
+			break;
+		}
+	}
+
+	_network_replaying = false;
+
+	/* The wall clock is only used to report the speed. */
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	IConsolePrint(CC_INFO, "Replayed {} ticks and {} commands in {} ms ({:.1f} ticks per second).",
+			tick, commands, elapsed.count(), elapsed.count() == 0 ? 0.0 : tick * 1000.0 / elapsed.count());
+	return in_sync;
+}
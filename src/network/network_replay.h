@@ -0,0 +1,22 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file network_replay.h Recording the game of a server, and replaying it. */
+
+#ifndef NETWORK_REPLAY_H
+#define NETWORK_REPLAY_H
+
+extern bool _network_replaying;
+
+bool NetworkReplayStartRecording(const std::string &filename);
+void NetworkReplayStopRecording();
+bool NetworkReplayIsRecording();
+void NetworkReplayRecordCommand(const struct CommandPacket &cp);
+void NetworkReplayRecordTick();
+bool NetworkReplayPlay(const std::string &filename, uint32_t max_ticks);
+
+#endif /* NETWORK_REPLAY_H */
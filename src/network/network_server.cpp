@@ -34,8 +34,8 @@
 #include "../timer/timer_game_calendar.h"
 #include "../timer/timer_game_economy.h"
 #include "../timer/timer_game_realtime.h"
+#include "../timer/timer_game_tick.h"
 #include <mutex>
-#include <condition_variable>
 
 #include "table/strings.h"
 
@@ -63,125 +63,125 @@ static NetworkAuthenticationDefaultAuthorizedKeyHandler _authorized_key_handler{
 static NetworkAuthenticationDefaultAuthorizedKeyHandler _rcon_authorized_key_handler{_settings_client.network.rcon_authorized_keys}; ///< Provides the authorized key validation for rcon.
 
 
-/** Writing a savegame directly to a number of packets. */
-struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
-	std::unique_ptr<Packet> current; ///< The packet we're currently writing to.
-	size_t total_size;                  ///< Total size of the compressed savegame.
-	std::deque<std::unique_ptr<Packet>> packets; ///< Packet queue of the savegame; send these "slowly" to the client. Cannot be a std::queue as we want to push the map size packet in front of the data packets.
-	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
-	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
+/**
+ * A compressed savegame that is shared by all clients that are downloading
+ * the map at about the same time. It is written once by the savegame thread,
+ * and every client streams the map from it at its own pace. Clients that join
+ * a snapshot after it has been made get the commands that have been executed
+ * since, so they can catch up from the frame of the snapshot.
+ */
+struct MapSnapshot : SaveFilter {
+	/** For how many ticks clients may still join a snapshot, before a fresh one is made. */
+	static constexpr uint32_t MAX_AGE = 10 * Ticks::TICKS_PER_SECOND;
+	/** How many bytes to packetise for a client at once, so not every client has a copy of the whole map in its packet queue. */
+	static constexpr size_t MAX_BYTES_PER_SEND = 16 * TCP_MTU;
+
+	const uint32_t frame; ///< The frame the game was saved at.
+	CommandQueue commands{}; ///< The commands that are to be executed from #frame onwards.
+	std::vector<uint8_t> data{}; ///< The compressed savegame written so far.
+	bool finished = false; ///< Whether the whole savegame has been written.
+	std::mutex mutex; ///< Mutex for making threaded saving safe.
 
 	/**
-	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
+	 * Create the snapshot of the current game state.
 	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), total_size(0)
+	MapSnapshot() : SaveFilter(nullptr), frame(_frame_counter)
 	{
-	}
-
-	/** Make sure everything is cleaned up under lock. */
-	~PacketWriter() override
-	{
-		std::unique_lock<std::mutex> lock(this->mutex);
-
-		while (this->cs != nullptr) this->exit_sig.wait(lock);
-
-		/* This must all wait until the Destroy function is called. */
-
-		this->packets.clear();
-		this->current = nullptr;
+		NetworkSyncCommandQueue(this->commands);
 	}
 
 	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
-	 * in the first case the client disconnected while saving the map. In this
-	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
+	 * Check whether new clients can still join this snapshot, i.e. whether
+	 * catching up on the commands since it was made is not too much work.
+	 * @return True iff clients may download this snapshot.
 	 */
-	void Destroy()
+	bool IsJoinable() const
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
-
-		this->cs = nullptr;
-
-		this->exit_sig.notify_all();
-		lock.unlock();
-
-		/* Make sure the saving is completely cancelled. Yes,
-		 * we need to handle the save finish as well as the
-		 * next connection might just be requesting a map. */
-		WaitTillSaved();
+		return _frame_counter - this->frame <= MAX_AGE;
 	}
 
 	/**
-	 * Transfer all packets from here to the network's queue while holding
-	 * the lock on our mutex.
+	 * Transfer the next part of the savegame to the network queue of a client.
+	 * @param cs The client to send the savegame to.
 	 * @return True iff the last packet of the map has been sent.
 	 */
-	bool TransferToNetworkQueue()
+	bool TransferToNetworkQueue(ServerNetworkGameSocketHandler *cs)
 	{
-		/* Unsafe check for the queue being empty or not. */
-		if (this->packets.empty()) return false;
+		/* Do not queue more while the previous part is still being sent. */
+		if (cs->HasSendQueue()) return false;
 
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		while (!this->packets.empty()) {
-			bool last_packet = this->packets.front()->GetPacketType() == to_underlying(PacketGameType::ServerMapDone);
-			this->cs->SendPacket(std::move(this->packets.front()));
-			this->packets.pop_front();
+		/* Only send full packets until the savegame is complete. */
+		size_t &pos = cs->savegame_pos;
+		size_t available = this->data.size() - pos;
+		if (!this->finished && available < TCP_MTU) return false;
+
+		if (this->finished && !cs->savegame_size_sent) {
+			/* Fast-track the size to the client. */
+			auto p = std::make_unique<Packet>(cs, PacketGameType::ServerMapSize);
+			p->Send_uint32(static_cast<uint32_t>(this->data.size()));
+			cs->SendPacket(std::move(p));
+			cs->savegame_size_sent = true;
+		}
 
-			if (last_packet) return true;
+		size_t end = pos + std::min(available, MAX_BYTES_PER_SEND);
+		while (pos < end && (this->finished || end - pos >= TCP_MTU)) {
+			auto p = std::make_unique<Packet>(cs, PacketGameType::ServerMapData, TCP_MTU);
+			std::span<const uint8_t> to_write(this->data.data() + pos, end - pos);
+			pos = end - p->Send_bytes(to_write).size();
+			cs->SendPacket(std::move(p));
 		}
 
-		return false;
+		if (!this->finished || pos != this->data.size()) return false;
+
+		cs->SendPacket(std::make_unique<Packet>(cs, PacketGameType::ServerMapDone));
+		return true;
 	}
 
 	void Write(uint8_t *buf, size_t size) override
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
-
-		if (this->current == nullptr) this->current = std::make_unique<Packet>(this->cs, PacketGameType::ServerMapData, TCP_MTU);
-
-		std::span<const uint8_t> to_write(buf, size);
-		while (!to_write.empty()) {
-			to_write = this->current->Send_bytes(to_write);
-
-			if (!this->current->CanWriteToPacket(1)) {
-				this->packets.push_back(std::move(this->current));
-				if (!to_write.empty()) this->current = std::make_unique<Packet>(this->cs, PacketGameType::ServerMapData, TCP_MTU);
-			}
-		}
-
-		this->total_size += size;
+		this->data.insert(this->data.end(), buf, buf + size);
 	}
 
 	void Finish() override
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
 
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+		this->finished = true;
+	}
+};
 
-		/* Make sure the last packet is flushed. */
-		if (this->current != nullptr) this->packets.push_back(std::move(this->current));
+/** The most recent map snapshot; it lives as long as it is being saved or downloaded. */
+static std::weak_ptr<MapSnapshot> _map_snapshot;
 
-		/* Add a packet stating that this is the end to the queue. */
-		this->packets.push_back(std::make_unique<Packet>(this->cs, PacketGameType::ServerMapDone));
+/**
+ * Record a command that has been distributed to the clients, so clients
+ * that join the current map snapshot later on can replay it.
+ * @param cp The distributed command.
+ */
+void NetworkRecordMapSnapshotCommand(const CommandPacket &cp)
+{
+	std::shared_ptr<MapSnapshot> snapshot = _map_snapshot.lock();
+	if (snapshot == nullptr || !snapshot->IsJoinable()) return;
 
-		/* Fast-track the size to the client. */
-		auto p = std::make_unique<Packet>(this->cs, PacketGameType::ServerMapSize);
-		p->Send_uint32((uint32_t)this->total_size);
-		this->packets.push_front(std::move(p));
-	}
-};
+	CommandPacket &c = snapshot->commands.emplace_back(cp);
+	c.callback = nullptr;
+	c.my_cmd = false;
+}
+
+/**
+ * Get the current map snapshot, if clients can still join it.
+ * @return The snapshot, or \c nullptr when a new one has to be made.
+ */
+static std::shared_ptr<MapSnapshot> GetJoinableMapSnapshot()
+{
+	std::shared_ptr<MapSnapshot> snapshot = _map_snapshot.lock();
+	if (snapshot == nullptr || !snapshot->IsJoinable()) return nullptr;
+	return snapshot;
+}
 
 
 /**
@@ -213,11 +213,6 @@ ServerNetworkGameSocketHandler::~ServerNetworkGameSocketHandler()
 	if (_redirect_console_to_client == this->client_id) _redirect_console_to_client = INVALID_CLIENT_ID;
 	OrderBackup::ResetUser(this->client_id);
 
-	if (this->savegame != nullptr) {
-		this->savegame->Destroy();
-		this->savegame = nullptr;
-	}
-
 	InvalidateWindowData(WC_CLIENT_LIST, 0);
 }
 
@@ -260,11 +255,9 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 		}
 	}
 
-	/* If we were transferring a map to this client, stop the savegame creation
-	 * process and queue the next client to receive the map. */
+	/* If we were transferring a map to this client, release our hold
+	 * on the snapshot and queue the next client to receive the map. */
 	if (this->status == STATUS_MAP) {
-		/* Ensure the saving of the game is stopped too. */
-		this->savegame->Destroy();
 		this->savegame = nullptr;
 
 		this->CheckNextClientToSendMap(this);
@@ -565,9 +558,16 @@ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocke
 		best->status = STATUS_AUTHORIZED;
 		best->SendMap();
 
-		/* And update the rest. */
+		/* And let the rest download the same snapshot. */
 		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-			if (new_cs->status == STATUS_MAP_WAIT) new_cs->SendWait();
+			if (new_cs->status != STATUS_MAP_WAIT) continue;
+
+			if (GetJoinableMapSnapshot() != nullptr) {
+				new_cs->status = STATUS_AUTHORIZED;
+				new_cs->SendMap();
+			} else {
+				new_cs->SendWait();
+			}
 		}
 	}
 }
@@ -586,15 +586,27 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 	if (this->status == STATUS_AUTHORIZED) {
 		Debug(net, 9, "client[{}] SendMap(): first_packet", this->client_id);
 
-		WaitTillSaved();
-		this->savegame = std::make_shared<PacketWriter>(this);
+		this->savegame = GetJoinableMapSnapshot();
+		this->savegame_pos = 0;
+		this->savegame_size_sent = false;
 
-		/* Now send the _frame_counter and how many packets are coming */
+		bool save = this->savegame == nullptr;
+		if (save) {
+			WaitTillSaved();
+			this->savegame = std::make_shared<MapSnapshot>();
+			_map_snapshot = this->savegame;
+		} else {
+			Debug(net, 3, "Client #{} joins the map snapshot of frame {}", this->client_id, this->savegame->frame);
+		}
+
+		/* Now send the frame of the snapshot and how many packets are coming */
 		auto p = std::make_unique<Packet>(this, PacketGameType::ServerMapBegin);
-		p->Send_uint32(_frame_counter);
+		p->Send_uint32(this->savegame->frame);
 		this->SendPacket(std::move(p));
 
-		NetworkSyncCommandQueue(this);
+		/* All commands from the snapshot's frame onwards; newer ones are distributed to us directly. */
+		for (const CommandPacket &cp : this->savegame->commands) this->outgoing_queue.push_back(cp);
+
 		Debug(net, 9, "client[{}] status = MAP", this->client_id);
 		this->status = STATUS_MAP;
 		/* Mark the start of download */
@@ -602,16 +614,15 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 		this->last_frame_server = _frame_counter;
 
 		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) UserError("network savedump failed");
+		if (save && SaveWithFilter(this->savegame, true) != SL_OK) UserError("network savedump failed");
 	}
 
 	if (this->status == STATUS_MAP) {
-		bool last_packet = this->savegame->TransferToNetworkQueue();
+		bool last_packet = this->savegame->TransferToNetworkQueue(this);
 		if (last_packet) {
 			Debug(net, 9, "client[{}] SendMap(): last_packet", this->client_id);
 
-			/* Done reading, make sure saving is done as well */
-			this->savegame->Destroy();
+			/* Done reading, release our hold on the snapshot */
 			this->savegame = nullptr;
 
 			/* Set the status to DONE_MAP, no we will wait for the client
@@ -688,21 +699,41 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 }
 
 /**
- * Send a command to the client to execute.
- * @param cp The command to send.
+ * Send commands to the client to execute. Commands of the same frame are
+ * bundled into as few packets as possible, and commands the client did not
+ * send itself use the encoding that is shared by all clients.
+ * @param queue The commands to send.
  * @return The new state the network.
  */
-NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommand(const CommandPacket &cp)
+NetworkRecvStatus ServerNetworkGameSocketHandler::SendCommands(const CommandQueue &queue)
 {
-	Debug(net, 9, "client[{}] SendCommand(): cmd={}", this->client_id, cp.cmd);
+	std::unique_ptr<Packet> p;
+	uint32_t frame = 0;
 
-	auto p = std::make_unique<Packet>(this, PacketGameType::ServerCommand);
+	for (const CommandPacket &cp : queue) {
+		Debug(net, 9, "client[{}] SendCommands(): cmd={}", this->client_id, cp.cmd);
 
-	this->NetworkGameSocketHandler::SendCommand(*p, cp);
-	p->Send_uint32(cp.frame);
-	p->Send_bool  (cp.my_cmd);
+		std::vector<uint8_t> own_encoding;
+		std::span<const uint8_t> encoded;
+		if (cp.encoded != nullptr && cp.callback == nullptr) {
+			encoded = *cp.encoded;
+		} else {
+			own_encoding = NetworkEncodeCommand(cp, cp.callback);
+			encoded = own_encoding;
+		}
 
-	this->SendPacket(std::move(p));
+		if (p != nullptr && (cp.frame != frame || !p->CanWriteToPacket(encoded.size() + sizeof(bool)))) this->SendPacket(std::move(p));
+		if (p == nullptr) {
+			p = std::make_unique<Packet>(this, PacketGameType::ServerCommandBatch, TCP_MTU);
+			p->Send_uint32(cp.frame);
+			frame = cp.frame;
+		}
+
+		p->Send_bytes(encoded);
+		p->Send_bool(cp.my_cmd);
+	}
+
+	if (p != nullptr) this->SendPacket(std::move(p));
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
@@ -1048,9 +1079,9 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::ReceiveClientGetMap(Packet &)
 
 	Debug(net, 9, "client[{}] ReceiveClientGetMap()", this->client_id);
 
-	/* Check if someone else is receiving the map */
+	/* Check if someone else is receiving a map we cannot share */
 	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (new_cs->status == STATUS_MAP) {
+		if (new_cs->status == STATUS_MAP && GetJoinableMapSnapshot() == nullptr) {
 			/* Tell the new client to wait */
 			Debug(net, 9, "client[{}] status = MAP_WAIT", this->client_id);
 			this->status = STATUS_MAP_WAIT;
@@ -1729,7 +1760,9 @@ bool NetworkServerChangeClientName(ClientID client_id, const std::string &new_na
  */
 static void NetworkHandleCommandQueue(NetworkClientSocket *cs)
 {
-	for (auto &cp : cs->outgoing_queue) cs->SendCommand(cp);
+	if (cs->outgoing_queue.empty()) return;
+
+	cs->SendCommands(cs->outgoing_queue);
 	cs->outgoing_queue.clear();
 }
 
@@ -1868,6 +1901,9 @@ void NetworkServer_Tick(bool send_frame)
 #endif
 		}
 	}
+
+	NetworkAdminPerformance();
+	NetworkAdminVehiclePositions();
 }
 
 /** Helper function to restart the map. */
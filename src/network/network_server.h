@@ -71,13 +71,16 @@ public:
 	CommandQueue outgoing_queue{}; ///< The command-queue awaiting delivery; conceptually more a bucket to gather commands in, after which the whole bucket is sent to the client.
 	size_t receive_limit = 0; ///< Amount of bytes that we can receive at this moment
 
-	std::shared_ptr<struct PacketWriter> savegame = nullptr; ///< Writer used to write the savegame.
+	std::shared_ptr<struct MapSnapshot> savegame = nullptr; ///< The savegame the map is sent from.
+	size_t savegame_pos = 0; ///< Number of bytes of the savegame that have been sent.
+	bool savegame_size_sent = false; ///< Whether the size of the savegame has been sent.
 	NetworkAddress client_address{}; ///< IP-address of the client (so they can be banned)
 
 	ServerNetworkGameSocketHandler(ClientPoolID index, SOCKET s);
 	~ServerNetworkGameSocketHandler() override;
 
 	std::unique_ptr<Packet> ReceivePacket() override;
+	bool MayReceive() const override { return this->receive_limit > 0; }
 	NetworkRecvStatus CloseConnection(NetworkRecvStatus status) override;
 	std::string GetClientName() const;
 
@@ -99,7 +102,7 @@ public:
 	NetworkRecvStatus SendJoin(ClientID client_id);
 	NetworkRecvStatus SendFrame();
 	NetworkRecvStatus SendSync();
-	NetworkRecvStatus SendCommand(const CommandPacket &cp);
+	NetworkRecvStatus SendCommands(const CommandQueue &queue);
 	NetworkRecvStatus SendConfigUpdate();
 
 	static void Send();
@@ -127,6 +130,7 @@ public:
 };
 
 void NetworkServer_Tick(bool send_frame);
+void NetworkRecordMapSnapshotCommand(const struct CommandPacket &cp);
 void ChangeNetworkRestartTime(bool reset);
 
 #endif /* NETWORK_SERVER_H */
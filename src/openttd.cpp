@@ -39,6 +39,7 @@
 #include "screenshot.h"
 #include "network/network.h"
 #include "network/network_func.h"
+#include "network/network_replay.h"
 #include "ai/ai.hpp"
 #include "ai/ai_config.hpp"
 #include "settings_func.h"
@@ -1047,6 +1048,9 @@ void SwitchToMode(SwitchMode new_mode)
 	/* Make sure all AI controllers are gone at quitting game */
 	if (new_mode != SM_SAVE_GAME) AI::KillAll();
 
+	/* A replay covers a single game. */
+	if (new_mode != SM_SAVE_GAME) NetworkReplayStopRecording();
+
 	/* When we change mode, reset the autosave. */
 	if (new_mode != SM_SAVE_GAME) ChangeAutosaveFrequency(true);
 
@@ -1223,7 +1227,8 @@ void StateGameLoop()
 
 		if (!HasModalProgress()) UpdateLandscapingLimits();
 #ifndef DEBUG_DUMP_COMMANDS
-		if (_game_mode == GM_NORMAL) Game::GameLoop();
+		/* Scripts do not run during replays; their commands are part of the replay. */
+		if (_game_mode == GM_NORMAL && !_network_replaying) Game::GameLoop();
 #endif
 		return;
 	}
@@ -1267,7 +1272,7 @@ void StateGameLoop()
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 
 #ifndef DEBUG_DUMP_COMMANDS
-		{
+		if (!_network_replaying) {
 			PerformanceMeasurer script_framerate(PFE_ALLSCRIPTS);
 			AI::GameLoop();
 			Game::GameLoop();
@@ -1275,7 +1280,7 @@ void StateGameLoop()
 #endif
 		UpdateLandscapingLimits();
 
-		CallWindowGameTickEvent();
+		if (!_network_catching_up) CallWindowGameTickEvent();
 		NewsLoop();
 		cur_company.Restore();
 	}
@@ -1386,7 +1391,7 @@ void GameLoop()
 		StateGameLoop();
 	}
 
-	if (_pause_mode.None() && HasBit(_display_opt, DO_FULL_ANIMATION)) DoPaletteAnimations();
+	if (_pause_mode.None() && HasBit(_display_opt, DO_FULL_ANIMATION) && !_network_catching_up) DoPaletteAnimations();
 
 	SoundDriver::GetInstance()->MainLoop();
 	MusicLoop();
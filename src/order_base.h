@@ -388,6 +388,10 @@ private:
 	friend struct ORDLChunkHandler;
 	template <typename T>
 	friend class SlOrders;
+	friend class LinkRefresher; ///< For caching the predicted links.
+
+	/** Pairs of orders the link refresher refreshes the links between, in order; the same for all vehicles sharing the order list. */
+	using LinkPrediction = std::vector<std::pair<VehicleOrderID, VehicleOrderID>>;
 
 	VehicleOrderID num_manual_orders = 0; ///< NOSAVE: How many manually added orders are there in the list.
 	uint num_vehicles = 0; ///< NOSAVE: Number of vehicles that share this order list.
@@ -398,7 +402,12 @@ private:
 	TimerGameTick::Ticks timetable_duration{}; ///< NOSAVE: Total timetabled duration of the order list.
 	TimerGameTick::Ticks total_duration{}; ///< NOSAVE: Total (timetabled or not) duration of the order list.
 
+	std::map<std::pair<VehicleOrderID, bool>, LinkPrediction> link_predictions{}; ///< NOSAVE: Cached link predictions, by the order they start at and whether the vehicle has cargo then.
+
 public:
+	/** Forget the cached link predictions, as the orders changed. */
+	inline void InvalidateLinkPredictions() { this->link_predictions.clear(); }
+
 	/**
 	 * Default constructor producing an invalid order list.
 	 * @param index index of the list within the order list pool
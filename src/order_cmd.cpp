@@ -305,6 +305,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 
 	if (keep_orderlist) {
 		this->orders.clear();
+		this->InvalidateLinkPredictions();
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
 	} else {
@@ -417,6 +418,7 @@ void OrderList::InsertOrderAt(Order &&order, VehicleOrderID index)
 {
 	auto it = std::ranges::next(std::begin(this->orders), index, std::end(this->orders));
 	auto new_order = this->orders.emplace(it, std::move(order));
+	this->InvalidateLinkPredictions();
 
 	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 	this->timetable_duration += new_order->GetTimetabledWait() + new_order->GetTimetabledTravel();
@@ -446,6 +448,7 @@ void OrderList::DeleteOrderAt(VehicleOrderID index)
 	this->total_duration -= (to_remove->GetWaitTime() + to_remove->GetTravelTime());
 
 	this->orders.erase(to_remove);
+	this->InvalidateLinkPredictions();
 }
 
 /**
@@ -465,6 +468,7 @@ void OrderList::MoveOrder(VehicleOrderID from, VehicleOrderID to)
 	} else {
 		std::rotate(it + to, it + from, it + from + 1);
 	}
+	this->InvalidateLinkPredictions();
 }
 
 /**
@@ -1329,6 +1333,8 @@ CommandCost CmdModifyOrder(DoCommandFlags flags, VehicleID veh, VehicleOrderID s
 	}
 
 	if (flags.Test(DoCommandFlag::Execute)) {
+		v->orders->InvalidateLinkPredictions();
+
 		switch (mof) {
 			case MOF_NON_STOP:
 				order->SetNonStopType(static_cast<OrderNonStopFlags>(data));
@@ -1651,6 +1657,7 @@ CommandCost CmdOrderRefit(DoCommandFlags flags, VehicleID veh, VehicleOrderID or
 
 	if (flags.Test(DoCommandFlag::Execute)) {
 		order->SetRefit(cargo);
+		v->orders->InvalidateLinkPredictions();
 
 		/* Make the depot order an 'always go' order. */
 		if (cargo != CARGO_NO_REFIT && order->IsType(OT_GOTO_DEPOT)) {
@@ -1797,6 +1804,7 @@ void RemoveOrderFromAllVehicles(OrderType type, DestinationID destination, bool
 				/* Clear order, preserving travel time */
 				bool travel_timetabled = order->IsTravelTimetabled();
 				order->MakeDummy();
+				v->orders->InvalidateLinkPredictions();
 				order->SetTravelTimetabled(travel_timetabled);
 
 				for (const Vehicle *w = v->FirstShared(); w != nullptr; w = w->NextShared()) {
@@ -484,8 +484,8 @@ public:
 			max_speed = std::min(max_speed, spd);
 		}
 		/* Check for in-tunnel speed limit */
-		if (IsTunnelTile(m_old_tile)) {
-			int spd = GetTunnelSpec(GetTunnelType(m_old_tile))->speed;
+		if (IsTunnelTile(this->old_tile)) {
+			int spd = GetTunnelSpec(GetTunnelType(this->old_tile))->speed;
 			if (IsRoadTT()) spd *= 2;
 			max_speed = std::min(max_speed, spd);
 		}
@@ -561,6 +561,7 @@ static void StartScripts()
 bool AfterLoadGame()
 {
 	SetSignalHandlers();
+	ResetAfterLoadProfile();
 
 	extern TileIndex _cur_tileloop_tile; // From landscape.cpp.
 	/* The LFSR used in RunTileLoop iteration cannot have a zeroed state, make it non-zeroed. */
@@ -798,9 +799,12 @@ bool AfterLoadGame()
 		_settings_game.linkgraph.recalc_time     *= CalendarTime::SECONDS_PER_DAY;
 	}
 
+	ProfileAfterLoadPhase("early conversions");
+
 	/* Load the sprites */
 	GfxLoadSprites();
 	LoadStringWidthTable();
+	ProfileAfterLoadPhase("sprites");
 
 	/* Copy temporary data to Engine pool */
 	CopyTempEngineData();
@@ -822,6 +826,7 @@ bool AfterLoadGame()
 
 	/* Update all vehicles: Phase 1 */
 	AfterLoadVehiclesPhase1(true);
+	ProfileAfterLoadPhase("vehicles phase 1");
 
 	/* Old orders are no longer needed. */
 	ClearOldOrders();
@@ -852,8 +857,8 @@ bool AfterLoadGame()
 		 * converted before SLV_72 and SLV_82 conversions which use GetWaterTileType. */
 		static constexpr uint8_t WBL_COAST_FLAG = 0; ///< Flag for coast.
 
-		for (auto t : Map::Iterate()) {
-			if (!IsTileType(t, TileType::Water)) continue;
+		Map::ParallelIterate([](Tile t) {
+			if (!IsTileType(t, TileType::Water)) return;
 
 			switch (GB(t.m5(), 4, 4)) {
 				case 0x0: /* Previously WBL_TYPE_NORMAL, Clear water or coast. */
@@ -864,7 +869,7 @@ bool AfterLoadGame()
 				case 0x8: SetWaterTileType(t, WaterTileType::Depot); break; /* Previously WBL_TYPE_DEPOT */
 				default: SetWaterTileType(t, WaterTileType::Clear); break; /* Shouldn't happen... */
 			}
-		}
+		});
 	}
 
 	if (IsSavegameVersionBefore(SLV_72)) {
@@ -1193,7 +1198,7 @@ bool AfterLoadGame()
 
 	/* Railtype moved from m3 to m8 in version SLV_EXTEND_RAILTYPES. */
 	if (IsSavegameVersionBefore(SLV_EXTEND_RAILTYPES)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			switch (GetTileType(t)) {
 				case TileType::Railway:
 					SetRailType(t, (RailType)GB(t.m3(), 0, 4));
@@ -1220,7 +1225,7 @@ bool AfterLoadGame()
 				default:
 					break;
 			}
-		}
+		});
 	}
 
 	if (IsSavegameVersionBefore(SLV_42)) {
@@ -1306,7 +1311,7 @@ bool AfterLoadGame()
 
 	if (IsSavegameVersionBefore(SLV_ROAD_TYPES)) {
 		/* Add road subtypes */
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			bool has_road = false;
 			switch (GetTileType(t)) {
 				case TileType::Road:
@@ -1330,7 +1335,7 @@ bool AfterLoadGame()
 				SetRoadTypes(t, road_rt, tram_rt);
 				SB(t.m7(), 6, 2, 0); // Clear pre-NRT road type bits.
 			}
-		}
+		});
 	}
 
 	/* Elrails got added in rev 24 */
@@ -1515,7 +1520,7 @@ bool AfterLoadGame()
 	/* From version 53, the map array was changed for house tiles to allow
 	 * space for newhouses grf features. A new byte, m7, was also added. */
 	if (IsSavegameVersionBefore(SLV_53)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			if (IsTileType(t, TileType::House)) {
 				if (GB(t.m3(), 6, 2) != TOWN_HOUSE_COMPLETED) {
 					/* Move the construction stage from m3[7..6] to m5[5..4].
@@ -1545,28 +1550,28 @@ bool AfterLoadGame()
 					SetHouseCompleted(t, true);
 				}
 			}
-		}
+		});
 	}
 
 	if (IsSavegameVersionBefore(SLV_INCREASE_HOUSE_LIMIT)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			if (IsTileType(t, TileType::House)) {
 				/* House type is moved from m4 + m3[6] to m8. */
 				SetHouseType(t, t.m4() | (GB(t.m3(), 6, 1) << 8));
 				t.m4() = 0;
 				ClrBit(t.m3(), 6);
 			}
-		}
+		});
 	}
 
 	if (IsSavegameVersionBefore(SLV_PROTECT_PLACED_HOUSES)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			if (IsTileType(t, TileType::House)) {
 				/* We now store house protection status in the map. Set this based on the house spec flags. */
 				const HouseSpec *hs = HouseSpec::Get(GetHouseType(t));
 				SetHouseProtected(t, hs->extra_flags.Test(HouseExtraFlag::BuildingIsProtected));
 			}
-		}
+		});
 	}
 
 	/* Check and update house and town values */
@@ -2022,7 +2027,7 @@ bool AfterLoadGame()
 	 * format here, as an old layout wouldn't work properly anyway. To be safe, we
 	 * clear any possible PBS reservations as well. */
 	if (IsSavegameVersionBefore(SLV_100)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			switch (GetTileType(t)) {
 				case TileType::Railway:
 					if (HasSignals(t)) {
@@ -2055,7 +2060,7 @@ bool AfterLoadGame()
 
 				default: break;
 			}
-		}
+		});
 	}
 
 	/* Reserve all tracks trains are currently on. */
@@ -2431,7 +2436,7 @@ bool AfterLoadGame()
 	/* The bits for the tree ground and tree density have
 	 * been swapped (m2 bits 7..6 and 5..4. */
 	if (IsSavegameVersionBefore(SLV_135)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			if (IsTileType(t, TileType::Clear)) {
 				if (GetClearGround(t) == ClearGround{4}) { // CLEAR_SNOW becomes ClearGround::Grass with IsSnowTile() set.
 					SetClearGroundDensity(t, ClearGround::Grass, GetClearDensity(t));
@@ -2445,7 +2450,7 @@ bool AfterLoadGame()
 				uint ground = GB(t.m2(), 4, 2);
 				t.m2() = ground << 6 | density << 4;
 			}
-		}
+		});
 	}
 
 	/* Wait counter and load/unload ticks got split. */
@@ -2562,7 +2567,7 @@ bool AfterLoadGame()
 
 	/* Move the animation frame to the same location (m7) for all objects. */
 	if (IsSavegameVersionBefore(SLV_147)) {
-		for (auto t : Map::Iterate()) {
+		Map::ParallelIterate([](Tile t) {
 			switch (GetTileType(t)) {
 				case TileType::House:
 					if (GetHouseType(t) >= NEW_HOUSE_OFFSET) {
@@ -2589,7 +2594,7 @@ bool AfterLoadGame()
 					/* For stations/airports it's already at m7 */
 					break;
 			}
-		}
+		});
 	}
 
 	/* Add (random) colour to all objects. */
@@ -3031,9 +3036,11 @@ bool AfterLoadGame()
 	}
 
 	/* Beyond this point, tile types which can be accessed by vehicles must be in a valid state. */
+	ProfileAfterLoadPhase("savegame conversions");
 
 	/* Update all vehicles: Phase 2 */
 	AfterLoadVehiclesPhase2(true);
+	ProfileAfterLoadPhase("vehicles phase 2");
 
 	/* The center of train vehicles was changed, fix up spacing. */
 	if (IsSavegameVersionBefore(SLV_164)) FixupTrainLengths();
@@ -3413,18 +3420,22 @@ bool AfterLoadGame()
 	AfterLoadStoryBook();
 
 	_gamelog.PrintDebug(1);
+	ProfileAfterLoadPhase("late conversions");
 
 	InitializeWindowsAndCaches();
 	/* Restore the signals */
 	ResetSignalHandlers();
+	ProfileAfterLoadPhase("windows and caches");
 
 	AfterLoadLinkGraphs();
 
 	CheckGroundVehiclesAtCorrectZ();
+	ProfileAfterLoadPhase("link graphs");
 
 	/* Start the scripts. This MUST happen after everything else except
 	 * starting a new company. */
 	StartScripts();
+	ProfileAfterLoadPhase("scripts");
 
 	/* If Load Scenario / New (Scenario) Game is used,
 	 *  a company does not exist yet. So create one here.
@@ -145,6 +145,8 @@ SaveLoadTable GetCargoPacketDesc()
 struct CAPAChunkHandler : ChunkHandler {
 	CAPAChunkHandler() : ChunkHandler('CAPA', CH_TABLE) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Save() const override
 	{
 		SlTableHeader(GetCargoPacketDesc());
@@ -66,207 +66,171 @@ struct MAPSChunkHandler : ChunkHandler {
 
 static const uint MAP_SL_BUF_SIZE = 4096;
 
+/**
+ * Load one of the map arrays. The values are read from the savegame in bulk
+ * and then distributed over the tiles.
+ * @tparam T Type of the values in memory.
+ * @param conv Conversion of the values in the savegame.
+ * @param field Function returning the field of a tile to load the value into.
+ */
+template <typename T, typename F>
+static void LoadMapArray(VarType conv, F field)
+{
+	std::array<T, MAP_SL_BUF_SIZE> buf;
+	uint size = Map::Size();
+
+	for (uint i = 0; i != size; i += MAP_SL_BUF_SIZE) {
+		SlCopy(buf.data(), MAP_SL_BUF_SIZE, conv);
+		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) field(Tile(TileIndex{i + j})) = buf[j];
+	}
+}
+
+/**
+ * Save one of the map arrays. The values are collected from the tiles and
+ * then written to the savegame in bulk.
+ * @tparam T Type of the values in memory and in the savegame.
+ * @param conv Conversion of the values in the savegame.
+ * @param field Function returning the value of the field of a tile to save.
+ */
+template <typename T, typename F>
+static void SaveMapArray(VarType conv, F field)
+{
+	std::array<T, MAP_SL_BUF_SIZE> buf;
+	uint size = Map::Size();
+
+	SlSetLength(static_cast<size_t>(size) * sizeof(T));
+	for (uint i = 0; i != size; i += MAP_SL_BUF_SIZE) {
+		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = field(Tile(TileIndex{i + j}));
+		SlCopy(buf.data(), MAP_SL_BUF_SIZE, conv);
+	}
+}
+
 struct MAPTChunkHandler : ChunkHandler {
 	MAPTChunkHandler() : ChunkHandler('MAPT', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).type() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.type(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).type();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.type(); });
 	}
 };
 
 struct MAPHChunkHandler : ChunkHandler {
 	MAPHChunkHandler() : ChunkHandler('MAPH', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).height() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.height(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).height();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.height(); });
 	}
 };
 
 struct MAPOChunkHandler : ChunkHandler {
 	MAPOChunkHandler() : ChunkHandler('MAPO', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m1() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.m1(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m1();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.m1(); });
 	}
 };
 
 struct MAP2ChunkHandler : ChunkHandler {
 	MAP2ChunkHandler() : ChunkHandler('MAP2', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint16_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE,
-				/* In those versions the m2 was 8 bits */
-				IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16
-			);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m2() = buf[j];
-		}
+		LoadMapArray<uint16_t>(
+			/* In those versions the m2 was 8 bits */
+			IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16,
+			[](Tile t) -> uint16_t & { return t.m2(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint16_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(static_cast<uint32_t>(size) * sizeof(uint16_t));
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m2();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-		}
+		SaveMapArray<uint16_t>(SLE_UINT16, [](Tile t) { return t.m2(); });
 	}
 };
 
 struct M3LOChunkHandler : ChunkHandler {
 	M3LOChunkHandler() : ChunkHandler('M3LO', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m3() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.m3(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m3();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.m3(); });
 	}
 };
 
 struct M3HIChunkHandler : ChunkHandler {
 	M3HIChunkHandler() : ChunkHandler('M3HI', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m4() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.m4(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m4();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.m4(); });
 	}
 };
 
 struct MAP5ChunkHandler : ChunkHandler {
 	MAP5ChunkHandler() : ChunkHandler('MAP5', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m5() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.m5(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m5();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.m5(); });
 	}
 };
 
 struct MAPEChunkHandler : ChunkHandler {
 	MAPEChunkHandler() : ChunkHandler('MAPE', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
 		if (IsSavegameVersionBefore(SLV_42)) {
+			std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
+			uint size = Map::Size();
+
 			for (TileIndex i{}; i != size;) {
 				/* 1024, otherwise we overflow on 64x64 maps! */
 				SlCopy(buf.data(), 1024, SLE_UINT8);
@@ -278,77 +242,45 @@ struct MAPEChunkHandler : ChunkHandler {
 				}
 			}
 		} else {
-			for (TileIndex i{}; i != size;) {
-				SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-				for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m6() = buf[j];
-			}
+			LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.m6(); });
 		}
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m6();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.m6(); });
 	}
 };
 
 struct MAP7ChunkHandler : ChunkHandler {
 	MAP7ChunkHandler() : ChunkHandler('MAP7', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m7() = buf[j];
-		}
+		LoadMapArray<uint8_t>(SLE_UINT8, [](Tile t) -> uint8_t & { return t.m7(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint8_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(size);
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m7();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapArray<uint8_t>(SLE_UINT8, [](Tile t) { return t.m7(); });
 	}
 };
 
 struct MAP8ChunkHandler : ChunkHandler {
 	MAP8ChunkHandler() : ChunkHandler('MAP8', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint16_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		for (TileIndex i{}; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) Tile(i++).m8() = buf[j];
-		}
+		LoadMapArray<uint16_t>(SLE_UINT16, [](Tile t) -> uint16_t & { return t.m8(); });
 	}
 
 	void Save() const override
 	{
-		std::array<uint16_t, MAP_SL_BUF_SIZE> buf;
-		uint size = Map::Size();
-
-		SlSetLength(static_cast<uint32_t>(size) * sizeof(uint16_t));
-		for (TileIndex i{}; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = Tile(i++).m8();
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-		}
+		SaveMapArray<uint16_t>(SLE_UINT16, [](Tile t) { return t.m8(); });
 	}
 };
 
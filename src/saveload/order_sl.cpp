@@ -251,6 +251,8 @@ SaveLoadTable GetOrderListDescription()
 struct ORDLChunkHandler : ChunkHandler {
 	ORDLChunkHandler() : ChunkHandler('ORDL', CH_TABLE) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Save() const override
 	{
 		const SaveLoadTable slt = GetOrderListDescription();
@@ -15,7 +15,7 @@
  * <li>use their description array (#SaveLoad) to know what elements to save and in what version
  *    of the game it was active (used when loading)
  * <li>write all data byte-by-byte to the temporary buffer so it is endian-safe
- * <li>when the buffer is full; flush it to the output (eg save to file) (_sl.buf, _sl.bufp, _sl.bufe)
+ * <li>when the buffer is full; flush it to the output (eg save to file) (_sl->buf, _sl->bufp, _sl->bufe)
  * <li>repeat this until everything is done, and flush any remaining output to file
  * </ol>
  */
@@ -52,9 +52,20 @@
 #include "saveload_filter.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #ifdef __EMSCRIPTEN__
 #	include <emscripten.h>
 #endif
+#if defined(__linux__)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
 
 #ifdef WITH_LZO
 #include <lzo/lzo1x.h>
@@ -68,6 +79,10 @@
 #include <lzma.h>
 #endif /* WITH_LIBLZMA */
 
+#if defined(WITH_ZSTD)
+#include <zstd.h>
+#endif /* WITH_ZSTD */
+
 #include "table/strings.h"
 
 #include "../safeguards.h"
@@ -81,8 +96,18 @@ uint32_t _ttdp_version;         ///< version of TTDP savegame (if applicable)
 SaveLoadVersion _sl_version;  ///< the major savegame version identifier
 uint8_t   _sl_minor_version;     ///< the minor savegame version, DO NOT USE!
 std::string _savegame_format; ///< how to compress savegames
+bool _savegame_block_compression; ///< whether to compress savegames in independent blocks, so they can be decompressed in parallel
+bool _savegame_fork_snapshot; ///< whether dedicated servers on Linux write threaded saves from a forked copy of the process
+uint8_t _autosave_differential; ///< number of differential autosaves between two full autosaves; 0 to always make full autosaves
+uint8_t _savegame_compression_threads; ///< number of worker threads to compress savegames with, if the format supports it; 0 for automatic
 bool _do_autosave;            ///< are we doing an autosave at the moment?
 
+static SaveLoadProfile _save_profile; ///< Profile of the last saved game.
+static SaveLoadProfile _save_profile_pending; ///< Profile of the game that is being saved.
+static SaveLoadProfile _load_profile; ///< Profile of the last loaded game.
+static SaveLoadProfile _load_profile_pending; ///< Profile of the game that is being loaded.
+static std::chrono::steady_clock::time_point _afterload_phase_start; ///< Start of the current phase of AfterLoadGame.
+
 /** What are we currently doing? */
 enum SaveLoadAction : uint8_t {
 	SLA_LOAD,        ///< loading
@@ -104,8 +129,8 @@ static const size_t MEMORY_CHUNK_SIZE = 128 * 1024;
 /** A buffer for reading (and buffering) savegame data. */
 struct ReadBuffer {
 	uint8_t buf[MEMORY_CHUNK_SIZE]; ///< Buffer we're going to read from.
-	uint8_t *bufp = nullptr; ///< Location we're at reading the buffer.
-	uint8_t *bufe = nullptr; ///< End of the buffer we can read from.
+	const uint8_t *bufp = nullptr; ///< Location we're at reading the buffer.
+	const uint8_t *bufe = nullptr; ///< End of the buffer we can read from.
 	std::shared_ptr<LoadFilter> reader{}; ///< The filter used to actually read.
 	size_t read = 0; ///< The amount of read bytes so far from the filter.
 
@@ -117,20 +142,53 @@ struct ReadBuffer {
 	{
 	}
 
-	inline uint8_t ReadByte()
+	/** Refill the buffer from the filter. */
+	void FillBuffer()
 	{
-		if (this->bufp == this->bufe) {
-			size_t len = this->reader->Read(this->buf, lengthof(this->buf));
-			if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
-
-			this->read += len;
-			this->bufp = this->buf;
-			this->bufe = this->buf + len;
+		/* Read directly from the filter's memory when it is able to, e.g. for uncompressed memory mapped savegames. */
+		std::optional<std::span<const uint8_t>> span = this->reader->ReadSpan(lengthof(this->buf));
+		if (span.has_value()) {
+			if (span->empty()) SlErrorCorrupt("Unexpected end of chunk");
+
+			this->read += span->size();
+			this->bufp = span->data();
+			this->bufe = span->data() + span->size();
+			return;
 		}
 
+		size_t len = this->reader->Read(this->buf, lengthof(this->buf));
+		if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+
+		this->read += len;
+		this->bufp = this->buf;
+		this->bufe = this->buf + len;
+	}
+
+	inline uint8_t ReadByte()
+	{
+		if (this->bufp == this->bufe) this->FillBuffer();
+
 		return *this->bufp++;
 	}
 
+	/**
+	 * Read a number of bytes from the buffer.
+	 * @param ptr The memory to read the bytes into.
+	 * @param length The number of bytes to read.
+	 */
+	void CopyBytes(uint8_t *ptr, size_t length)
+	{
+		while (length > 0) {
+			if (this->bufp == this->bufe) this->FillBuffer();
+
+			size_t to_copy = std::min<size_t>(length, this->bufe - this->bufp);
+			std::copy_n(this->bufp, to_copy, ptr);
+			this->bufp += to_copy;
+			ptr += to_copy;
+			length -= to_copy;
+		}
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
@@ -142,11 +200,40 @@ struct ReadBuffer {
 };
 
 
+/**
+ * Continue a 64 bits hash over some bytes. The bytes are hashed a word
+ * at a time, so hashing in parts gives the same result as hashing at once
+ * as long as each part but the last is a multiple of 8 bytes long.
+ * @param hash The hash of the preceding bytes.
+ * @param data The bytes to hash.
+ * @return The hash including the given bytes.
+ */
+static uint64_t HashBytes(uint64_t hash, std::span<const uint8_t> data)
+{
+	static const uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+	size_t i = 0;
+	for (; i + 8 <= data.size(); i += 8) {
+		uint64_t word = 0;
+		for (size_t j = 0; j < 8; j++) word |= static_cast<uint64_t>(data[i + j]) << (8 * j);
+		hash = std::rotl(hash ^ word, 29) * MULTIPLIER;
+	}
+	for (; i < data.size(); i++) hash = std::rotl(hash ^ data[i], 29) * MULTIPLIER;
+	return hash;
+}
+
 /** Container for dumping the savegame (quickly) to memory. */
 struct MemoryDumper {
-	std::vector<std::unique_ptr<uint8_t[]>> blocks{}; ///< Buffer with blocks of allocated memory.
+	/** A block of allocated memory of MEMORY_CHUNK_SIZE bytes. */
+	struct Block {
+		std::unique_ptr<uint8_t[]> data; ///< The memory of the block.
+		size_t size = 0; ///< Number of bytes used, except for the last block where it is determined by #buf.
+	};
+
+	std::vector<Block> blocks{}; ///< Buffer with blocks of allocated memory.
 	uint8_t *buf = nullptr; ///< Buffer we're going to write to.
 	uint8_t *bufe = nullptr; ///< End of the buffer we write to.
+	size_t sealed_size = 0; ///< Number of bytes in all blocks but the last one.
 
 	/**
 	 * Write a single byte into the dumper.
@@ -155,28 +242,147 @@ struct MemoryDumper {
 	inline void WriteByte(uint8_t b)
 	{
 		/* Are we at the end of this chunk? */
-		if (this->buf == this->bufe) {
-			this->buf = this->blocks.emplace_back(std::make_unique<uint8_t[]>(MEMORY_CHUNK_SIZE)).get();
-			this->bufe = this->buf + MEMORY_CHUNK_SIZE;
-		}
+		if (this->buf == this->bufe) this->AllocateBlock();
 
 		*this->buf++ = b;
 	}
 
+	/**
+	 * Write a number of bytes into the dumper.
+	 * @param data The bytes to write.
+	 * @param length The number of bytes to write.
+	 */
+	void Write(const uint8_t *data, size_t length)
+	{
+		while (length > 0) {
+			if (this->buf == this->bufe) this->AllocateBlock();
+
+			size_t to_write = std::min<size_t>(length, this->bufe - this->buf);
+			std::copy_n(data, to_write, this->buf);
+			this->buf += to_write;
+			data += to_write;
+			length -= to_write;
+		}
+	}
+
+	/**
+	 * Get the number of bytes written to a block.
+	 * @param i The index of the block.
+	 * @return The number of bytes.
+	 */
+	size_t GetBlockSize(size_t i) const
+	{
+		if (i + 1 == this->blocks.size()) return this->buf - this->blocks[i].data.get();
+		return this->blocks[i].size;
+	}
+
+	/**
+	 * Get the used part of a block.
+	 * @param i The index of the block.
+	 * @return The bytes written to the block.
+	 */
+	std::span<const uint8_t> GetBlock(size_t i) const
+	{
+		return {this->blocks[i].data.get(), this->GetBlockSize(i)};
+	}
+
+	/**
+	 * Copy a part of the data of this dumper to another dumper.
+	 * @param offset The offset of the data to copy.
+	 * @param size The number of bytes to copy.
+	 * @param dest The dumper to copy the data to.
+	 */
+	void CopyTo(size_t offset, size_t size, MemoryDumper &dest) const
+	{
+		assert(offset + size <= this->GetSize());
+
+		for (size_t i = 0; size > 0; i++) {
+			std::span<const uint8_t> block = this->GetBlock(i);
+			if (offset >= block.size()) {
+				offset -= block.size();
+				continue;
+			}
+
+			size_t to_write = std::min(block.size() - offset, size);
+			dest.Write(block.data() + offset, to_write);
+			offset = 0;
+			size -= to_write;
+		}
+	}
+
+	/**
+	 * Calculate the hash of the data of this dumper, see HashBytes.
+	 * The blocks can be partially filled, so the bytes are fed in whole words
+	 * to get the same hash as for the data in one piece.
+	 * @return The hash.
+	 */
+	uint64_t Hash() const
+	{
+		uint64_t hash = 0;
+		std::array<uint8_t, 8> pending;
+		size_t num_pending = 0;
+
+		for (size_t i = 0; i < this->blocks.size(); i++) {
+			std::span<const uint8_t> block = this->GetBlock(i);
+			if (num_pending > 0) {
+				size_t to_fill = std::min(pending.size() - num_pending, block.size());
+				std::copy_n(block.begin(), to_fill, pending.begin() + num_pending);
+				num_pending += to_fill;
+				block = block.subspan(to_fill);
+				if (num_pending < pending.size()) continue;
+
+				hash = HashBytes(hash, pending);
+				num_pending = 0;
+			}
+
+			size_t whole_words = block.size() - block.size() % pending.size();
+			hash = HashBytes(hash, block.first(whole_words));
+			std::ranges::copy(block.subspan(whole_words), pending.begin());
+			num_pending = block.size() - whole_words;
+		}
+		return HashBytes(hash, std::span{pending}.first(num_pending));
+	}
+
+	/**
+	 * Move everything written to another dumper to the end of this dumper.
+	 * The blocks are taken over as they are, so the last block of this dumper
+	 * is left partially filled.
+	 * @param other The dumper to take the data from; it is empty afterwards.
+	 */
+	void Append(MemoryDumper &&other)
+	{
+		if (other.blocks.empty()) return;
+
+		this->SealBlock();
+		other.SealBlock();
+		this->sealed_size += other.sealed_size;
+		std::ranges::move(other.blocks, std::back_inserter(this->blocks));
+		other.blocks.clear();
+		other.buf = other.bufe = nullptr;
+		other.sealed_size = 0;
+
+		/* Continue writing in the last block that was taken over. */
+		Block &last = this->blocks.back();
+		this->sealed_size -= last.size;
+		this->buf = last.data.get() + last.size;
+		this->bufe = last.data.get() + MEMORY_CHUNK_SIZE;
+	}
+
 	/**
 	 * Flush this dumper into a writer.
 	 * @param writer The filter we want to use.
+	 * @param progress Optional function called with the number of bytes flushed so far, after each block.
 	 */
-	void Flush(std::shared_ptr<SaveFilter> writer)
+	void Flush(std::shared_ptr<SaveFilter> writer, const std::function<void(size_t)> &progress = {})
 	{
-		uint i = 0;
-		size_t t = this->GetSize();
+		size_t flushed = 0;
 
-		while (t > 0) {
-			size_t to_write = std::min(MEMORY_CHUNK_SIZE, t);
+		for (size_t i = 0; i < this->blocks.size(); i++) {
+			size_t to_write = this->GetBlockSize(i);
 
-			writer->Write(this->blocks[i++].get(), to_write);
-			t -= to_write;
+			writer->Write(this->blocks[i].data.get(), to_write);
+			flushed += to_write;
+			if (progress) progress(flushed);
 		}
 
 		writer->Finish();
@@ -188,7 +394,27 @@ struct MemoryDumper {
 	 */
 	size_t GetSize() const
 	{
-		return this->blocks.size() * MEMORY_CHUNK_SIZE - (this->bufe - this->buf);
+		if (this->blocks.empty()) return 0;
+		return this->sealed_size + (this->buf - this->blocks.back().data.get());
+	}
+
+private:
+	/** Record the number of bytes used in the last block, before it stops being the last one. */
+	void SealBlock()
+	{
+		if (this->blocks.empty()) return;
+
+		Block &last = this->blocks.back();
+		last.size = this->buf - last.data.get();
+		this->sealed_size += last.size;
+	}
+
+	/** Start writing in a new block. */
+	void AllocateBlock()
+	{
+		this->SealBlock();
+		this->buf = this->blocks.emplace_back(Block{std::make_unique<uint8_t[]>(MEMORY_CHUNK_SIZE)}).data.get();
+		this->bufe = this->buf + MEMORY_CHUNK_SIZE;
 	}
 };
 
@@ -213,9 +439,12 @@ struct SaveLoadParams {
 	std::string extra_msg;               ///< the error message
 
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
+	bool keep_profile;                   ///< Whether to keep the profile of the current save, i.e. when saving to a file.
+	bool differential;                   ///< Whether the dumper contains a differential savegame.
 };
 
-static SaveLoadParams _sl; ///< Parameters used for/at saveload.
+static SaveLoadParams _sl_game; ///< Parameters used for/at saveload by the game and savegame threads.
+static thread_local SaveLoadParams *_sl = &_sl_game; ///< Parameters used for/at saveload by the current thread; threads saving chunks concurrently have their own.
 
 static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 {
@@ -313,7 +542,7 @@ static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 /** Null all pointers (convert index -> nullptr) */
 static void SlNullPointers()
 {
-	_sl.action = SLA_NULL;
+	_sl->action = SLA_NULL;
 
 	/* We don't want any savegame conversion code to run
 	 * during NULLing; especially those that try to get
@@ -325,7 +554,7 @@ static void SlNullPointers()
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_NULL);
+	assert(_sl->action == SLA_NULL);
 }
 
 /**
@@ -339,22 +568,23 @@ static void SlNullPointers()
 [[noreturn]] void SlError(StringID string, const std::string &extra_msg)
 {
 	/* Distinguish between loading into _load_check_data vs. normal save/load. */
-	if (_sl.action == SLA_LOAD_CHECK) {
+	if (_sl->action == SLA_LOAD_CHECK) {
 		_load_check_data.error = string;
 		_load_check_data.error_msg = extra_msg;
 	} else {
-		_sl.error_str = string;
-		_sl.extra_msg = extra_msg;
+		_sl->error_str = string;
+		_sl->extra_msg = extra_msg;
 	}
 
 	/* We have to nullptr all pointers here; we might be in a state where
 	 * the pointers are actually filled with indices, which means that
 	 * when we access them during cleaning the pool dereferences of
 	 * those indices will be made with segmentation faults as result. */
-	if (_sl.action == SLA_LOAD || _sl.action == SLA_PTRS) SlNullPointers();
+	if (_sl->action == SLA_LOAD || _sl->action == SLA_PTRS) SlNullPointers();
 
-	/* Logging could be active. */
-	_gamelog.StopAnyAction();
+	/* Logging could be active. Threads with saveload parameters of their own
+	 * leave this to the thread that passes their error on. */
+	if (_sl == &_sl_game) _gamelog.StopAnyAction();
 
 	throw std::exception();
 }
@@ -388,11 +618,19 @@ static void SetAsyncSaveFinish(AsyncSaveFinishProc proc)
 	_async_save_finish.store(proc, std::memory_order_release);
 }
 
+#if defined(__linux__)
+static void CheckSnapshotSave(bool wait);
+#endif
+
 /**
  * Handle async save finishes.
  */
 void ProcessAsyncSaveFinish()
 {
+#if defined(__linux__)
+	CheckSnapshotSave(false);
+#endif
+
 	AsyncSaveFinishProc proc = _async_save_finish.exchange(nullptr, std::memory_order_acq_rel);
 	if (proc == nullptr) return;
 
@@ -409,7 +647,7 @@ void ProcessAsyncSaveFinish()
  */
 uint8_t SlReadByte()
 {
-	return _sl.reader->ReadByte();
+	return _sl->reader->ReadByte();
 }
 
 /**
@@ -418,7 +656,7 @@ uint8_t SlReadByte()
  */
 void SlWriteByte(uint8_t b)
 {
-	_sl.dumper->WriteByte(b);
+	_sl->dumper->WriteByte(b);
 }
 
 static inline int SlReadUint16()
@@ -673,8 +911,8 @@ static inline size_t SlCalcRefLen()
 
 void SlSetArrayIndex(uint index)
 {
-	_sl.need_length = NL_WANTLENGTH;
-	_sl.array_index = index;
+	_sl->need_length = NL_WANTLENGTH;
+	_sl->array_index = index;
 }
 
 static size_t _next_offs;
@@ -687,32 +925,32 @@ int SlIterateArray()
 {
 	/* After reading in the whole array inside the loop
 	 * we must have read in all the data, so we must be at end of current block. */
-	if (_next_offs != 0 && _sl.reader->GetSize() != _next_offs) {
-		SlErrorCorruptFmt("Invalid chunk size iterating array - expected to be at position {}, actually at {}", _next_offs, _sl.reader->GetSize());
+	if (_next_offs != 0 && _sl->reader->GetSize() != _next_offs) {
+		SlErrorCorruptFmt("Invalid chunk size iterating array - expected to be at position {}, actually at {}", _next_offs, _sl->reader->GetSize());
 	}
 
 	for (;;) {
 		uint length = SlReadArrayLength();
 		if (length == 0) {
-			assert(!_sl.expect_table_header);
+			assert(!_sl->expect_table_header);
 			_next_offs = 0;
 			return -1;
 		}
 
-		_sl.obj_len = --length;
-		_next_offs = _sl.reader->GetSize() + length;
+		_sl->obj_len = --length;
+		_next_offs = _sl->reader->GetSize() + length;
 
-		if (_sl.expect_table_header) {
-			_sl.expect_table_header = false;
+		if (_sl->expect_table_header) {
+			_sl->expect_table_header = false;
 			return INT32_MAX;
 		}
 
 		int index;
-		switch (_sl.block_mode) {
+		switch (_sl->block_mode) {
 			case CH_SPARSE_TABLE:
 			case CH_SPARSE_ARRAY: index = (int)SlReadSparseIndex(); break;
 			case CH_TABLE:
-			case CH_ARRAY:        index = _sl.array_index++; break;
+			case CH_ARRAY:        index = _sl->array_index++; break;
 			default:
 				Debug(sl, 0, "SlIterateArray error");
 				return -1; // error
@@ -728,7 +966,7 @@ int SlIterateArray()
 void SlSkipArray()
 {
 	while (SlIterateArray() != -1) {
-		SlSkipBytes(_next_offs - _sl.reader->GetSize());
+		SlSkipBytes(_next_offs - _sl->reader->GetSize());
 	}
 }
 
@@ -739,18 +977,18 @@ void SlSkipArray()
  */
 void SlSetLength(size_t length)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
-	switch (_sl.need_length) {
+	switch (_sl->need_length) {
 		case NL_WANTLENGTH:
-			_sl.need_length = NL_NONE;
-			if ((_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) && _sl.expect_table_header) {
-				_sl.expect_table_header = false;
+			_sl->need_length = NL_NONE;
+			if ((_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) && _sl->expect_table_header) {
+				_sl->expect_table_header = false;
 				SlWriteArrayLength(length + 1);
 				break;
 			}
 
-			switch (_sl.block_mode) {
+			switch (_sl->block_mode) {
 				case CH_RIFF:
 					/* Ugly encoding of >16M RIFF chunks
 					 * The lower 24 bits are normal
@@ -760,23 +998,23 @@ void SlSetLength(size_t length)
 					break;
 				case CH_TABLE:
 				case CH_ARRAY:
-					assert(_sl.last_array_index <= _sl.array_index);
-					while (++_sl.last_array_index <= _sl.array_index) {
+					assert(_sl->last_array_index <= _sl->array_index);
+					while (++_sl->last_array_index <= _sl->array_index) {
 						SlWriteArrayLength(1);
 					}
 					SlWriteArrayLength(length + 1);
 					break;
 				case CH_SPARSE_TABLE:
 				case CH_SPARSE_ARRAY:
-					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl.array_index)); // Also include length of sparse index.
-					SlWriteSparseIndex(_sl.array_index);
+					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl->array_index)); // Also include length of sparse index.
+					SlWriteSparseIndex(_sl->array_index);
 					break;
 				default: NOT_REACHED();
 			}
 			break;
 
 		case NL_CALCLENGTH:
-			_sl.obj_len += (int)length;
+			_sl->obj_len += (int)length;
 			break;
 
 		default: NOT_REACHED();
@@ -793,14 +1031,54 @@ static void SlCopyBytes(void *ptr, size_t length)
 {
 	uint8_t *p = (uint8_t *)ptr;
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
-			for (; length != 0; length--) *p++ = SlReadByte();
+			_sl->reader->CopyBytes(p, length);
 			break;
 		case SLA_SAVE:
-			for (; length != 0; length--) SlWriteByte(*p++);
+			_sl->dumper->Write(p, length);
+			break;
+		default: NOT_REACHED();
+	}
+}
+
+/**
+ * Save/Load an array of integers which have the same size in the savegame and in memory.
+ * They are copied in bulk, and only converted between big and native endianness.
+ * @tparam T The type of the integers.
+ * @param object The array of integers.
+ * @param length The number of integers in the array.
+ */
+template <typename T>
+static void SlCopyIntegers(T *object, size_t length)
+{
+	switch (_sl->action) {
+		case SLA_LOAD_CHECK:
+		case SLA_LOAD:
+			SlCopyBytes(object, length * sizeof(T));
+			if constexpr (std::endian::native == std::endian::little) {
+				for (size_t i = 0; i != length; i++) object[i] = std::byteswap(object[i]);
+			}
 			break;
+
+		case SLA_SAVE: {
+			if constexpr (std::endian::native == std::endian::big) {
+				SlCopyBytes(object, length * sizeof(T));
+				break;
+			}
+
+			std::array<T, 1024> buf;
+			while (length > 0) {
+				size_t to_copy = std::min(length, buf.size());
+				for (size_t i = 0; i != to_copy; i++) buf[i] = std::byteswap(object[i]);
+				SlCopyBytes(buf.data(), to_copy * sizeof(T));
+				object += to_copy;
+				length -= to_copy;
+			}
+			break;
+		}
+
 		default: NOT_REACHED();
 	}
 }
@@ -811,7 +1089,7 @@ static void SlCopyBytes(void *ptr, size_t length)
  */
 size_t SlGetFieldLength()
 {
-	return _sl.obj_len;
+	return _sl->obj_len;
 }
 
 /**
@@ -873,7 +1151,7 @@ void WriteValue(void *ptr, VarType conv, int64_t val)
  */
 static void SlSaveLoadConv(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			int64_t x = ReadValue(ptr, conv);
 
@@ -1064,7 +1342,7 @@ static void SlStdString(void *ptr, VarType conv)
 {
 	std::string *str = reinterpret_cast<std::string *>(ptr);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			size_t len = str->length();
 			SlWriteArrayLength(len);
@@ -1114,14 +1392,14 @@ static void SlStdString(void *ptr, VarType conv)
 static void SlCopyInternal(void *object, size_t length, VarType conv)
 {
 	if (GetVarMemType(conv) == SLE_VAR_NULL) {
-		assert(_sl.action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
+		assert(_sl->action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
 		SlSkipBytes(length * SlCalcConvFileLen(conv));
 		return;
 	}
 
 	/* NOTICE - handle some buggy stuff, in really old versions everything was saved
 	 * as a byte-type. So detect this, and adjust object size accordingly */
-	if (_sl.action != SLA_SAVE && _sl_version == 0) {
+	if (_sl->action != SLA_SAVE && _sl_version == 0) {
 		/* all objects except difficulty settings */
 		if (conv == SLE_INT16 || conv == SLE_UINT16 || conv == SLE_STRINGID ||
 				conv == SLE_INT32 || conv == SLE_UINT32) {
@@ -1141,6 +1419,10 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
 	 * conversion is needed, use specialized copy-copy function to speed up things */
 	if (conv == SLE_INT8 || conv == SLE_UINT8) {
 		SlCopyBytes(object, length);
+	} else if (conv == SLE_INT16 || conv == SLE_UINT16) {
+		SlCopyIntegers(static_cast<uint16_t *>(object), length);
+	} else if (conv == SLE_INT32 || conv == SLE_UINT32) {
+		SlCopyIntegers(static_cast<uint32_t *>(object), length);
 	} else {
 		uint8_t *a = (uint8_t*)object;
 		uint8_t mem_size = SlCalcConvMemLen(conv);
@@ -1162,13 +1444,13 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
  */
 void SlCopy(void *object, size_t length, VarType conv)
 {
-	if (_sl.action == SLA_PTRS || _sl.action == SLA_NULL) return;
+	if (_sl->action == SLA_PTRS || _sl->action == SLA_NULL) return;
 
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(length * SlCalcConvFileLen(conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlCopyInternal(object, length, conv);
@@ -1193,7 +1475,7 @@ static inline size_t SlCalcArrayLen(size_t length, VarType conv)
  */
 static void SlArray(void *array, size_t length, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteArrayLength(length);
 			SlCopyInternal(array, length, conv);
@@ -1239,7 +1521,7 @@ static void SlArray(void *array, size_t length, VarType conv)
  */
 static size_t ReferenceToInt(const void *obj, SLRefType rt)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (obj == nullptr) return 0;
 
@@ -1273,7 +1555,7 @@ static void *IntToReference(size_t index, SLRefType rt)
 {
 	static_assert(sizeof(size_t) <= sizeof(void *));
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 
 	/* After version 4.3 REF_VEHICLE_OLD is saved as REF_VEHICLE,
 	 * and should be loaded like that */
@@ -1341,7 +1623,7 @@ static void *IntToReference(size_t index, SLRefType rt)
  */
 void SlSaveLoadRef(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteUint32((uint32_t)ReferenceToInt(*(void **)ptr, (SLRefType)conv));
 			break;
@@ -1407,7 +1689,7 @@ public:
 
 		SlStorageT *list = static_cast<SlStorageT *>(storage);
 
-		switch (_sl.action) {
+		switch (_sl->action) {
 			case SLA_SAVE:
 				SlWriteArrayLength(list->size());
 
@@ -1473,10 +1755,10 @@ static inline size_t SlCalcRefListLen(const void *list, VarType conv)
 static void SlRefList(void *list, VarType conv)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcRefListLen(list, conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlStorageHelper<std::list, void *>::SlSaveLoad(list, conv, SL_REF);
@@ -1501,10 +1783,10 @@ static size_t SlCalcRefVectorLen(const void *vector, VarType conv)
 static void SlRefVector(void *vector, VarType conv)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcRefVectorLen(vector, conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlStorageHelper<std::vector, void *>::SlSaveLoad(vector, conv, SL_REF);
@@ -1561,7 +1843,7 @@ static void SlDeque(void *deque, VarType conv)
 			 * these may not be directly stored in another length-prefixed container type.
 			 * This is permitted for load-related actions, because invalid fields of this type are present
 			 * from SLV_COMPANY_ALLOW_LIST up to SLV_COMPANY_ALLOW_LIST_V2. */
-			assert(_sl.action != SLA_SAVE);
+			assert(_sl->action != SLA_SAVE);
 			SlStorageHelper<std::deque, std::string>::SlSaveLoad(deque, conv, SL_STDSTR);
 			break;
 
@@ -1620,7 +1902,7 @@ static void SlVector(void *vector, VarType conv)
 			 * these may not be directly stored in another length-prefixed container type.
 			 * This is permitted for load-related actions, because invalid fields of this type are present
 			 * from SLV_COMPANY_ALLOW_LIST up to SLV_COMPANY_ALLOW_LIST_V2. */
-			assert(_sl.action != SLA_SAVE);
+			assert(_sl->action != SLA_SAVE);
 			SlStorageHelper<std::vector, std::string>::SlSaveLoad(vector, conv, SL_STDSTR);
 			break;
 
@@ -1685,7 +1967,7 @@ size_t SlCalcObjLength(const void *object, const SaveLoadTable &slt)
 
 size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (!SlIsObjectValidInSavegame(sld)) return 0;
 
@@ -1703,20 +1985,20 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST: {
-			NeedLength old_need_length = _sl.need_length;
-			size_t old_obj_len = _sl.obj_len;
+			NeedLength old_need_length = _sl->need_length;
+			size_t old_obj_len = _sl->obj_len;
 
-			_sl.need_length = NL_CALCLENGTH;
-			_sl.obj_len = 0;
+			_sl->need_length = NL_CALCLENGTH;
+			_sl->obj_len = 0;
 
 			/* Pretend that we are saving to collect the object size. Other
 			 * means are difficult, as we don't know the length of the list we
 			 * are about to store. */
 			sld.handler->Save(const_cast<void *>(object));
-			size_t length = _sl.obj_len;
+			size_t length = _sl->obj_len;
 
-			_sl.obj_len = old_obj_len;
-			_sl.need_length = old_need_length;
+			_sl->obj_len = old_obj_len;
+			_sl->need_length = old_need_length;
 
 			if (sld.cmd == SL_STRUCT) {
 				length += SlGetArrayLength(1);
@@ -1766,7 +2048,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_SAVEBYTE: {
 			void *ptr = GetVariableAddress(object, sld);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: SlWriteByte(*(uint8_t *)ptr); break;
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD:
@@ -1780,7 +2062,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_NULL: {
 			assert(GetVarMemType(sld.conv) == SLE_VAR_NULL);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD: SlSkipBytes(SlCalcConvFileLen(sld.conv) * sld.length); break;
 				case SLA_SAVE: for (int i = 0; i < SlCalcConvFileLen(sld.conv) * sld.length; i++) SlWriteByte(0); break;
@@ -1793,7 +2075,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST:
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: {
 					if (sld.cmd == SL_STRUCT) {
 						/* Store in the savegame if this struct was written or not. */
@@ -1840,9 +2122,9 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 void SlSetStructListLength(size_t length)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlGetArrayLength(length));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlWriteArrayLength(length);
@@ -1869,9 +2151,9 @@ size_t SlGetStructListLength(size_t limit)
 void SlObject(void *object, const SaveLoadTable &slt)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcObjLength(object, slt));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	for (auto &sld : slt) {
@@ -1922,9 +2204,9 @@ class SlSkipHandler : public SaveLoadHandler {
 std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 {
 	/* You can only use SlTableHeader if you are a CH_TABLE. */
-	assert(_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	assert(_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD: {
 			std::vector<SaveLoad> saveloads;
@@ -1950,7 +2232,7 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				auto sld_it = key_lookup.find(key);
 				if (sld_it == key_lookup.end()) {
 					/* SLA_LOADCHECK triggers this debug statement a lot and is perfectly normal. */
-					Debug(sl, _sl.action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
+					Debug(sl, _sl->action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
 
 					std::shared_ptr<SaveLoadHandler> handler = nullptr;
 					SaveLoadType saveload_type;
@@ -2000,9 +2282,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 
 		case SLA_SAVE: {
 			/* Automatically calculate the length? */
-			if (_sl.need_length != NL_NONE) {
+			if (_sl->need_length != NL_NONE) {
 				SlSetLength(SlCalcTableHeader(slt));
-				if (_sl.need_length == NL_CALCLENGTH) break;
+				if (_sl->need_length == NL_CALCLENGTH) break;
 			}
 
 			for (auto &sld : slt) {
@@ -2026,12 +2308,12 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				if (!SlIsObjectValidInSavegame(sld)) continue;
 				if (sld.cmd == SL_STRUCTLIST || sld.cmd == SL_STRUCT) {
 					/* SlCalcTableHeader already looks in sub-lists, so avoid the length being added twice. */
-					NeedLength old_need_length = _sl.need_length;
-					_sl.need_length = NL_NONE;
+					NeedLength old_need_length = _sl->need_length;
+					_sl->need_length = NL_NONE;
 
 					SlTableHeader(sld.handler->GetDescription());
 
-					_sl.need_length = old_need_length;
+					_sl->need_length = old_need_length;
 				}
 			}
 
@@ -2059,9 +2341,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
  */
 std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
 {
-	assert(_sl.action == SLA_LOAD || _sl.action == SLA_LOAD_CHECK);
+	assert(_sl->action == SLA_LOAD || _sl->action == SLA_LOAD_CHECK);
 	/* CH_TABLE / CH_SPARSE_TABLE always have a header. */
-	if (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
+	if (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
 
 	std::vector<SaveLoad> saveloads;
 
@@ -2123,31 +2405,31 @@ void SlGlobList(const SaveLoadTable &slt)
  */
 void SlAutolength(AutolengthProc *proc, int arg)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	/* Tell it to calculate the length */
-	_sl.need_length = NL_CALCLENGTH;
-	_sl.obj_len = 0;
+	_sl->need_length = NL_CALCLENGTH;
+	_sl->obj_len = 0;
 	proc(arg);
 
 	/* Setup length */
-	_sl.need_length = NL_WANTLENGTH;
-	SlSetLength(_sl.obj_len);
+	_sl->need_length = NL_WANTLENGTH;
+	SlSetLength(_sl->obj_len);
 
-	size_t start_pos = _sl.dumper->GetSize();
-	size_t expected_offs = start_pos + _sl.obj_len;
+	size_t start_pos = _sl->dumper->GetSize();
+	size_t expected_offs = start_pos + _sl->obj_len;
 
 	/* And write the stuff */
 	proc(arg);
 
-	if (expected_offs != _sl.dumper->GetSize()) {
-		SlErrorCorruptFmt("Invalid chunk size when writing autolength block, expected {}, got {}", _sl.obj_len, _sl.dumper->GetSize() - start_pos);
+	if (expected_offs != _sl->dumper->GetSize()) {
+		SlErrorCorruptFmt("Invalid chunk size when writing autolength block, expected {}, got {}", _sl->obj_len, _sl->dumper->GetSize() - start_pos);
 	}
 }
 
 void ChunkHandler::LoadCheck(size_t len) const
 {
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_SPARSE_TABLE:
 			SlTableHeader({});
@@ -2172,20 +2454,20 @@ static void SlLoadChunk(const ChunkHandler &ch)
 {
 	uint8_t m = SlReadByte();
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * Load() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		if (SlIterateArray() != INT32_MAX) SlErrorCorrupt("Table chunk without header");
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.Load();
 			if (_next_offs != 0) SlErrorCorrupt("Invalid array length");
 			break;
@@ -2198,13 +2480,13 @@ static void SlLoadChunk(const ChunkHandler &ch)
 			/* Read length */
 			size_t len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			size_t start_pos = _sl.reader->GetSize();
+			_sl->obj_len = len;
+			size_t start_pos = _sl->reader->GetSize();
 			size_t endoffs = start_pos + len;
 			ch.Load();
 
-			if (_sl.reader->GetSize() != endoffs) {
-				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl.reader->GetSize() - start_pos);
+			if (_sl->reader->GetSize() != endoffs) {
+				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl->reader->GetSize() - start_pos);
 			}
 			break;
 		}
@@ -2213,7 +2495,7 @@ static void SlLoadChunk(const ChunkHandler &ch)
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2225,20 +2507,20 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 {
 	uint8_t m = SlReadByte();
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * LoadCheck() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		if (SlIterateArray() != INT32_MAX) SlErrorCorrupt("Table chunk without header");
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.LoadCheck();
 			break;
 		case CH_SPARSE_TABLE:
@@ -2249,13 +2531,13 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 			/* Read length */
 			size_t len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			size_t start_pos = _sl.reader->GetSize();
+			_sl->obj_len = len;
+			size_t start_pos = _sl->reader->GetSize();
 			size_t endoffs = start_pos + len;
 			ch.LoadCheck(len);
 
-			if (_sl.reader->GetSize() != endoffs) {
-				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl.reader->GetSize() - start_pos);
+			if (_sl->reader->GetSize() != endoffs) {
+				SlErrorCorruptFmt("Invalid chunk size in RIFF in {} - expected {}, got {}", ch.GetName(), len, _sl->reader->GetSize() - start_pos);
 			}
 			break;
 		}
@@ -2264,7 +2546,7 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2279,40 +2561,146 @@ static void SlSaveChunk(const ChunkHandler &ch)
 	SlWriteUint32(ch.id);
 	Debug(sl, 2, "Saving chunk {}", ch.GetName());
 
-	_sl.block_mode = ch.type;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = ch.type;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	_sl.need_length = (_sl.expect_table_header || _sl.block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
+	_sl->need_length = (_sl->expect_table_header || _sl->block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_RIFF:
 			ch.Save();
 			break;
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.last_array_index = 0;
-			SlWriteByte(_sl.block_mode);
+			_sl->last_array_index = 0;
+			SlWriteByte(_sl->block_mode);
 			ch.Save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		case CH_SPARSE_TABLE:
 		case CH_SPARSE_ARRAY:
-			SlWriteByte(_sl.block_mode);
+			SlWriteByte(_sl->block_mode);
 			ch.Save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		default: NOT_REACHED();
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
-/** Save all chunks */
-static void SlSaveChunks()
+/** Result of saving a single chunk into its own buffer. */
+struct SavedChunk {
+	std::unique_ptr<MemoryDumper> dumper; ///< Data of the chunk.
+	std::chrono::steady_clock::duration time{}; ///< Time it took to save the chunk.
+	bool concurrent = false; ///< Whether the chunk was saved concurrently with other chunks.
+	StringID error_str = INVALID_STRING_ID; ///< The error that occurred while saving the chunk, if any.
+	std::string extra_msg{}; ///< Extra error message that occurred while saving the chunk.
+};
+
+/**
+ * Save a chunk into its own buffer, using saveload parameters local to the calling thread.
+ * Errors are recorded in the result instead of being thrown.
+ * @param ch The chunk handler to save.
+ * @param[out] result The buffer, timing and error of the chunk.
+ */
+static void SlSaveChunkToBuffer(const ChunkHandler &ch, SavedChunk &result)
 {
-	for (auto &ch : ChunkHandlers()) {
+	SaveLoadParams params{};
+	params.action = SLA_SAVE;
+	params.dumper = std::make_unique<MemoryDumper>();
+
+	SaveLoadParams *old_sl = _sl;
+	_sl = &params;
+
+	auto start = std::chrono::steady_clock::now();
+	try {
 		SlSaveChunk(ch);
+	} catch (...) {
+		result.error_str = params.error_str;
+		result.extra_msg = params.extra_msg;
+	}
+	result.time = std::chrono::steady_clock::now() - start;
+	result.dumper = std::move(params.dumper);
+
+	_sl = old_sl;
+}
+
+/** Identification of the contents of a saved chunk, to find unchanged chunks for differential autosaves. */
+struct ChunkDigest {
+	uint32_t id; ///< Identifier of the chunk.
+	size_t offset; ///< Offset of the chunk in the uncompressed savegame.
+	size_t size; ///< Number of bytes of the chunk.
+	uint64_t hash; ///< Hash of the bytes of the chunk.
+};
+
+/**
+ * Save all chunks.
+ * Chunks that only read game state are saved by worker threads into buffers
+ * of their own, while the calling thread saves the remaining chunks. The
+ * buffers are concatenated in the order of the chunk handlers afterwards, so
+ * the result is the same as saving all chunks one after another.
+ * @param[out] digests When not \c nullptr, filled with the digests of the saved chunks.
+ * @param use_threads Whether worker threads may be started; when not, the calling thread saves all chunks.
+ */
+static void SlSaveChunks(std::vector<ChunkDigest> *digests = nullptr, bool use_threads = true)
+{
+	const std::vector<ChunkHandlerRef> &handlers = ChunkHandlers();
+	std::vector<SavedChunk> chunks(handlers.size());
+
+	std::vector<size_t> concurrent;
+	for (size_t i = 0; i < handlers.size(); i++) {
+		if (handlers[i].get().type != CH_READONLY && handlers[i].get().CanSaveConcurrently()) concurrent.push_back(i);
+	}
+
+	std::atomic<size_t> next_concurrent = 0;
+	auto save_concurrent_chunks = [&handlers, &chunks, &concurrent, &next_concurrent]() {
+		for (size_t i = next_concurrent++; i < concurrent.size(); i = next_concurrent++) {
+			chunks[concurrent[i]].concurrent = true;
+			SlSaveChunkToBuffer(handlers[concurrent[i]], chunks[concurrent[i]]);
+		}
+	};
+
+	/* The calling thread does its share of work as well, so one thread less is needed. */
+	uint num_threads = use_threads ? std::min<uint>(std::max(std::thread::hardware_concurrency(), 1U) - 1, static_cast<uint>(concurrent.size())) : 0;
+	std::vector<std::thread> threads(num_threads);
+	uint started_threads = 0;
+	for (std::thread &thread : threads) {
+		if (!StartNewThread(&thread, "ottd:savechunk", [&save_concurrent_chunks]() { save_concurrent_chunks(); })) break;
+		started_threads++;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < handlers.size(); i++) {
+		if (handlers[i].get().type == CH_READONLY || handlers[i].get().CanSaveConcurrently()) continue;
+		SlSaveChunkToBuffer(handlers[i], chunks[i]);
+	}
+	/* Help the workers with the remaining chunks, or save all of them if no threads could be started. */
+	save_concurrent_chunks();
+
+	for (std::thread &thread : threads) {
+		if (thread.joinable()) thread.join();
+	}
+	auto total = std::chrono::steady_clock::now() - start;
+
+	_save_profile_pending = {};
+	_save_profile_pending.chunks_time = total;
+
+	for (size_t i = 0; i < handlers.size(); i++) {
+		SavedChunk &chunk = chunks[i];
+		if (chunk.dumper == nullptr) continue;
+
+		if (chunk.error_str != INVALID_STRING_ID) SlError(chunk.error_str, chunk.extra_msg);
+
+		Debug(sl, 2, "Saved chunk {}: {} bytes in {} us{}", handlers[i].get().GetName(), chunk.dumper->GetSize(),
+			std::chrono::duration_cast<std::chrono::microseconds>(chunk.time).count(), chunk.concurrent ? " (concurrently)" : "");
+		_save_profile_pending.chunks.emplace_back(std::string{handlers[i].get().GetName()}, _sl->dumper->GetSize(), chunk.dumper->GetSize(), 0, chunk.time);
+		if (digests != nullptr) digests->emplace_back(handlers[i].get().id, _sl->dumper->GetSize(), chunk.dumper->GetSize(), chunk.dumper->Hash());
+		_sl->dumper->Append(std::move(*chunk.dumper));
+		chunk.dumper.reset();
 	}
+	Debug(sl, 1, "Saved {} chunks in {} us, {} of them concurrently using {} threads", handlers.size(),
+		std::chrono::duration_cast<std::chrono::microseconds>(total).count(), concurrent.size(), started_threads + 1);
 
 	/* Terminator */
 	SlWriteUint32(0);
@@ -2336,13 +2724,26 @@ static void SlLoadChunks()
 	uint32_t id;
 	const ChunkHandler *ch;
 
+	auto start = std::chrono::steady_clock::now();
+	size_t offset = _sl->reader->GetSize();
 	for (id = SlReadUint32(); id != 0; id = SlReadUint32()) {
 		Debug(sl, 2, "Loading chunk {:c}{:c}{:c}{:c}", id >> 24, id >> 16, id >> 8, id);
 
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
+
+		auto chunk_start = std::chrono::steady_clock::now();
 		SlLoadChunk(*ch);
+
+		size_t end = _sl->reader->GetSize();
+		_load_profile_pending.chunks.emplace_back(std::string{ch->GetName()}, offset, end - offset, 0, std::chrono::steady_clock::now() - chunk_start);
+		offset = end;
 	}
+	_load_profile_pending.size = _sl->reader->GetSize();
+	_load_profile_pending.chunks_time = std::chrono::steady_clock::now() - start;
+
+	Debug(sl, 1, "Loaded {} chunks, {} bytes in {} us", _load_profile_pending.chunks.size(), _load_profile_pending.size,
+		std::chrono::duration_cast<std::chrono::microseconds>(_load_profile_pending.chunks_time).count());
 }
 
 /** Load all chunks for savegame checking */
@@ -2363,14 +2764,14 @@ static void SlLoadCheckChunks()
 /** Fix all pointers (convert index -> pointer) */
 static void SlFixPointers()
 {
-	_sl.action = SLA_PTRS;
+	_sl->action = SLA_PTRS;
 
 	for (const ChunkHandler &ch : ChunkHandlers()) {
 		Debug(sl, 3, "Fixing pointers for {}", ch.GetName());
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 }
 
 
@@ -2412,6 +2813,77 @@ struct FileReader : LoadFilter {
 	}
 };
 
+#if defined(__linux__)
+/** Reading from a file that is mapped into memory, so the data can be used without copying it first. */
+struct MappedFileReader : LoadFilter {
+	const uint8_t *data; ///< The mapped file.
+	size_t size; ///< The size of the mapped file.
+	size_t begin; ///< The begin of the savegame in the file.
+	size_t pos; ///< The position of the next byte to read.
+
+	/**
+	 * Create the reader for a mapped file.
+	 * @param data The mapped file.
+	 * @param size The size of the mapped file.
+	 * @param begin The begin of the savegame in the file.
+	 */
+	MappedFileReader(const uint8_t *data, size_t size, size_t begin) : LoadFilter(nullptr), data(data), size(size), begin(begin), pos(begin)
+	{
+	}
+
+	/** Make sure everything is cleaned up. */
+	~MappedFileReader() override
+	{
+		_game_session_stats.savegame_size = this->pos - this->begin;
+		munmap(const_cast<uint8_t *>(this->data), this->size);
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		std::span<const uint8_t> span = *this->ReadSpan(size);
+		std::copy(span.begin(), span.end(), buf);
+		return span.size();
+	}
+
+	std::optional<std::span<const uint8_t>> ReadSpan(size_t len) override
+	{
+		len = std::min(len, this->size - this->pos);
+		std::span<const uint8_t> span{this->data + this->pos, len};
+		this->pos += len;
+		return span;
+	}
+
+	void Reset() override
+	{
+		this->pos = this->begin;
+	}
+};
+#endif /* __linux__ */
+
+/**
+ * Create the filter reading a savegame from a file.
+ * Where possible the file is mapped into memory, so the decompressor reads
+ * straight from the page cache instead of from a copy of it.
+ * @param file The file to read from, positioned at the begin of the savegame.
+ * @return The created load filter.
+ */
+static std::shared_ptr<LoadFilter> CreateFileReader(FileHandle &&file)
+{
+#if defined(__linux__)
+	long begin = ftell(file);
+	struct stat st;
+	if (begin >= 0 && fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode) && st.st_size > begin) {
+		void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+		if (data != MAP_FAILED) {
+			madvise(data, st.st_size, MADV_SEQUENTIAL);
+			return std::make_shared<MappedFileReader>(static_cast<const uint8_t *>(data), st.st_size, begin);
+		}
+		Debug(sl, 1, "Could not map savegame into memory, reading it instead");
+	}
+#endif /* __linux__ */
+	return std::make_shared<FileReader>(std::move(file));
+}
+
 /** Yes, simply writing to a file. */
 struct FileWriter : SaveFilter {
 	std::optional<FileHandle> file; ///< The file to write to.
@@ -2447,6 +2919,58 @@ struct FileWriter : SaveFilter {
 	}
 };
 
+/** Filter counting the bytes that are written through it. */
+struct CountingSaveFilter : SaveFilter {
+	size_t written = 0; ///< Number of bytes written so far.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	CountingSaveFilter(std::shared_ptr<SaveFilter> chain) : SaveFilter(std::move(chain))
+	{
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->written += size;
+		this->chain->Write(buf, size);
+	}
+};
+
+/** Filter counting the bytes that are read through it. */
+struct CountingLoadFilter : LoadFilter {
+	size_t read = 0; ///< Number of bytes read so far.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	CountingLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(std::move(chain))
+	{
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size_t len = this->chain->Read(buf, size);
+		this->read += len;
+		return len;
+	}
+
+	std::optional<std::span<const uint8_t>> ReadSpan(size_t len) override
+	{
+		std::optional<std::span<const uint8_t>> span = this->chain->ReadSpan(len);
+		if (span.has_value()) this->read += span->size();
+		return span;
+	}
+
+	void Reset() override
+	{
+		this->read = 0;
+		this->chain->Reset();
+	}
+};
+
 /*******************************************
  ********** START OF LZO CODE **************
  *******************************************/
@@ -2557,6 +3081,11 @@ struct NoCompLoadFilter : LoadFilter {
 	{
 		return this->chain->Read(buf, size);
 	}
+
+	std::optional<std::span<const uint8_t>> ReadSpan(size_t len) override
+	{
+		return this->chain->ReadSpan(len);
+	}
 };
 
 /** Filter without any compression. */
@@ -2609,8 +3138,14 @@ struct ZlibLoadFilter : LoadFilter {
 		do {
 			/* read more bytes from the file? */
 			if (this->z.avail_in == 0) {
-				this->z.next_in = this->fread_buf;
-				this->z.avail_in = (uint)this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				std::optional<std::span<const uint8_t>> span = this->chain->ReadSpan(sizeof(this->fread_buf));
+				if (span.has_value()) {
+					this->z.next_in = const_cast<uint8_t *>(span->data());
+					this->z.avail_in = (uint)span->size();
+				} else {
+					this->z.next_in = this->fread_buf;
+					this->z.avail_in = (uint)this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				}
 			}
 
 			/* inflate the data */
@@ -2736,8 +3271,14 @@ struct LZMALoadFilter : LoadFilter {
 		do {
 			/* read more bytes from the file? */
 			if (this->lzma.avail_in == 0) {
-				this->lzma.next_in  = this->fread_buf;
-				this->lzma.avail_in = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				std::optional<std::span<const uint8_t>> span = this->chain->ReadSpan(sizeof(this->fread_buf));
+				if (span.has_value()) {
+					this->lzma.next_in  = span->data();
+					this->lzma.avail_in = span->size();
+				} else {
+					this->lzma.next_in  = this->fread_buf;
+					this->lzma.avail_in = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				}
 			}
 
 			/* inflate the data */
@@ -2811,39 +3352,165 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
-/*******************************************
- ************* END OF CODE *****************
- *******************************************/
+/********************************************
+ ********** START OF ZSTD CODE **************
+ ********************************************/
 
-/** The format for a reader/writer type of a savegame */
-struct SaveLoadFormat {
-	std::shared_ptr<LoadFilter> (*init_load)(std::shared_ptr<LoadFilter> chain); ///< Constructor for the load filter.
-	std::shared_ptr<SaveFilter> (*init_write)(std::shared_ptr<SaveFilter> chain, uint8_t compression); ///< Constructor for the save filter.
+#if defined(WITH_ZSTD)
 
-	std::string_view name; ///< name of the compressor/decompressor (debug-only)
-	uint32_t tag; ///< the 4-letter tag by which it is identified in the savegame
+/** Filter using Zstandard decompression. */
+struct ZSTDLoadFilter : LoadFilter {
+	ZSTD_DCtx *zstd; ///< Decompression context.
+	ZSTD_inBuffer input{}; ///< Data read from the file that still needs to be decompressed.
+	uint8_t fread_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for reading from the file.
 
-	uint8_t min_compression;                 ///< the minimum compression level of this format
-	uint8_t default_compression;             ///< the default compression level of this format
-	uint8_t max_compression;                 ///< the maximum compression level of this format
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	ZSTDLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(std::move(chain)), zstd(ZSTD_createDCtx())
+	{
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize decompressor");
+		this->input.src = this->fread_buf;
+	}
+
+	/** Clean everything up. */
+	~ZSTDLoadFilter() override
+	{
+		ZSTD_freeDCtx(this->zstd);
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		ZSTD_outBuffer output = { buf, size, 0 };
+
+		while (output.pos != output.size) {
+			/* read more bytes from the file? */
+			if (this->input.pos == this->input.size) {
+				std::optional<std::span<const uint8_t>> span = this->chain->ReadSpan(sizeof(this->fread_buf));
+				if (span.has_value()) {
+					this->input.src = span->data();
+					this->input.size = span->size();
+				} else {
+					this->input.src = this->fread_buf;
+					this->input.size = this->chain->Read(this->fread_buf, sizeof(this->fread_buf));
+				}
+				this->input.pos = 0;
+			}
+
+			/* At the end of the file the decoder may still hold data, so keep calling it till it has nothing more. */
+			size_t pos = output.pos;
+			size_t r = ZSTD_decompressStream(this->zstd, &output, &this->input);
+			if (ZSTD_isError(r)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("libzstd returned error: {}", ZSTD_getErrorName(r)));
+			if (this->input.size == 0 && (r == 0 || output.pos == pos)) break;
+		}
+
+		return output.pos;
+	}
 };
 
-static const uint32_t SAVEGAME_TAG_LZO = TO_BE32('OTTD');
-static const uint32_t SAVEGAME_TAG_NONE = TO_BE32('OTTN');
-static const uint32_t SAVEGAME_TAG_ZLIB = TO_BE32('OTTZ');
-static const uint32_t SAVEGAME_TAG_LZMA = TO_BE32('OTTX');
+/** Filter using Zstandard compression. */
+struct ZSTDSaveFilter : SaveFilter {
+	ZSTD_CCtx *zstd; ///< Compression context.
+	uint8_t fwrite_buf[MEMORY_CHUNK_SIZE]; ///< Buffer for writing to the file.
 
-/** The different saveload formats known/understood by OpenTTD. */
-static const SaveLoadFormat _saveload_formats[] = {
-#if defined(WITH_LZO)
-	/* Roughly 75% larger than zlib level 6 at only ~7% of the CPU usage. */
-	{CreateLoadFilter<LZOLoadFilter>, CreateSaveFilter<LZOSaveFilter>, "lzo", SAVEGAME_TAG_LZO, 0, 0, 0},
-#else
-	{nullptr, nullptr, "lzo", SAVEGAME_TAG_LZO, 0, 0, 0},
-#endif
-	/* Roughly 5 times larger at only 1% of the CPU usage over zlib level 6. */
-	{CreateLoadFilter<NoCompLoadFilter>, CreateSaveFilter<NoCompSaveFilter>, "none", SAVEGAME_TAG_NONE, 0, 0, 0},
-#if defined(WITH_ZLIB)
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	ZSTDSaveFilter(std::shared_ptr<SaveFilter> chain, uint8_t compression_level) : SaveFilter(std::move(chain)), zstd(ZSTD_createCCtx())
+	{
+		if (this->zstd == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+		if (ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_compressionLevel, compression_level))) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+
+		uint workers = _savegame_compression_threads != 0 ? _savegame_compression_threads : std::min(std::thread::hardware_concurrency(), 4U);
+		if (workers > 1 && ZSTD_isError(ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_nbWorkers, workers))) {
+			/* libzstd has been built without multithreading support; compress in this thread instead. */
+			Debug(sl, 1, "Cannot compress savegame with {} threads, using a single thread", workers);
+		}
+	}
+
+	/** Clean up what we allocated. */
+	~ZSTDSaveFilter() override
+	{
+		ZSTD_freeCCtx(this->zstd);
+	}
+
+	/**
+	 * Helper loop for writing the data.
+	 * @param p    The bytes to write.
+	 * @param len  Amount of bytes to write.
+	 * @param mode Directive for ZSTD_compressStream2.
+	 */
+	void WriteLoop(uint8_t *p, size_t len, ZSTD_EndDirective mode)
+	{
+		ZSTD_inBuffer input = { p, len, 0 };
+		size_t remaining;
+		do {
+			ZSTD_outBuffer output = { this->fwrite_buf, sizeof(this->fwrite_buf), 0 };
+
+			remaining = ZSTD_compressStream2(this->zstd, &output, &input, mode);
+			if (ZSTD_isError(remaining)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("libzstd returned error: {}", ZSTD_getErrorName(remaining)));
+
+			/* bytes were emitted? */
+			if (output.pos != 0) this->chain->Write(this->fwrite_buf, output.pos);
+		} while (mode == ZSTD_e_end ? remaining != 0 : input.pos != input.size);
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->WriteLoop(buf, size, ZSTD_e_continue);
+	}
+
+	void Finish() override
+	{
+		this->WriteLoop(nullptr, 0, ZSTD_e_end);
+		this->chain->Finish();
+	}
+};
+
+#endif /* WITH_ZSTD */
+
+/*******************************************
+ ************* END OF CODE *****************
+ *******************************************/
+
+/** The format for a reader/writer type of a savegame */
+struct SaveLoadFormat {
+	std::shared_ptr<LoadFilter> (*init_load)(std::shared_ptr<LoadFilter> chain); ///< Constructor for the load filter.
+	std::shared_ptr<SaveFilter> (*init_write)(std::shared_ptr<SaveFilter> chain, uint8_t compression); ///< Constructor for the save filter.
+
+	std::string_view name; ///< name of the compressor/decompressor (debug-only)
+	uint32_t tag; ///< the 4-letter tag by which it is identified in the savegame
+
+	uint8_t min_compression;                 ///< the minimum compression level of this format
+	uint8_t default_compression;             ///< the default compression level of this format
+	uint8_t max_compression;                 ///< the maximum compression level of this format
+};
+
+static const uint32_t SAVEGAME_TAG_LZO = TO_BE32('OTTD');
+static const uint32_t SAVEGAME_TAG_NONE = TO_BE32('OTTN');
+static const uint32_t SAVEGAME_TAG_ZLIB = TO_BE32('OTTZ');
+static const uint32_t SAVEGAME_TAG_LZMA = TO_BE32('OTTX');
+static const uint32_t SAVEGAME_TAG_ZSTD = TO_BE32('OTTS');
+static const uint32_t SAVEGAME_TAG_BLOCKS = TO_BE32('OTTB');
+static const uint32_t SAVEGAME_TAG_DELTA = TO_BE32('OTTI');
+
+static std::shared_ptr<LoadFilter> CreateBlockLoadFilter(std::shared_ptr<LoadFilter> chain);
+static std::shared_ptr<LoadFilter> CreateDeltaLoadFilter(std::shared_ptr<LoadFilter> chain);
+
+/** The different saveload formats known/understood by OpenTTD. */
+static const SaveLoadFormat _saveload_formats[] = {
+#if defined(WITH_LZO)
+	/* Roughly 75% larger than zlib level 6 at only ~7% of the CPU usage. */
+	{CreateLoadFilter<LZOLoadFilter>, CreateSaveFilter<LZOSaveFilter>, "lzo", SAVEGAME_TAG_LZO, 0, 0, 0},
+#else
+	{nullptr, nullptr, "lzo", SAVEGAME_TAG_LZO, 0, 0, 0},
+#endif
+	/* Roughly 5 times larger at only 1% of the CPU usage over zlib level 6. */
+	{CreateLoadFilter<NoCompLoadFilter>, CreateSaveFilter<NoCompSaveFilter>, "none", SAVEGAME_TAG_NONE, 0, 0, 0},
+#if defined(WITH_ZLIB)
 	/* After level 6 the speed reduction is significant (1.5x to 2.5x slower per level), but the reduction in filesize is
 	 * fairly insignificant (~1% for each step). Lower levels become ~5-10% bigger by each level than level 6 while level
 	 * 1 is "only" 3 times as fast. Level 0 results in uncompressed savegames at about 8 times the cost of "none". */
@@ -2851,6 +3518,16 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{nullptr, nullptr, "zlib", SAVEGAME_TAG_ZLIB, 0, 0, 0},
 #endif
+#if defined(WITH_ZSTD)
+	/* Zstandard decompresses a lot faster than LZMA and can compress with multiple threads, see
+	 * _savegame_compression_threads, which makes it suitable for frequent autosaves of large games.
+	 * Levels above 19 need a lot of memory for little gain, so they are not offered. It is never
+	 * the default, see GetSavegameFormat, so it is only used when explicitly chosen, as older
+	 * versions cannot load it. */
+	{CreateLoadFilter<ZSTDLoadFilter>, CreateSaveFilter<ZSTDSaveFilter>, "zstd", SAVEGAME_TAG_ZSTD, 1, 3, 19},
+#else
+	{nullptr, nullptr, "zstd", SAVEGAME_TAG_ZSTD, 0, 0, 0},
+#endif
 #if defined(WITH_LIBLZMA)
 	/* Level 2 compression is speed wise as fast as zlib level 6 compression (old default), but results in ~10% smaller saves.
 	 * Higher compression levels are possible, and might improve savegame size by up to 25%, but are also up to 10 times slower.
@@ -2861,8 +3538,604 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{nullptr, nullptr, "lzma", SAVEGAME_TAG_LZMA, 0, 0, 0},
 #endif
+	/* Container of independently compressed blocks of one of the formats above, see _savegame_block_compression.
+	 * It can only be loaded, as it is written by wrapping the chosen format. */
+	{CreateBlockLoadFilter, nullptr, "blocks", SAVEGAME_TAG_BLOCKS, 0, 0, 0},
+	/* Differences of an autosave to an earlier full autosave, see _autosave_differential.
+	 * It can only be loaded, as it is written by wrapping the chosen format. */
+	{CreateDeltaLoadFilter, nullptr, "differential", SAVEGAME_TAG_DELTA, 0, 0, 0},
+};
+
+/********************************************
+ ********** START OF BLOCK CODE *************
+ ********************************************/
+
+/** Size of the uncompressed data in each block of a block compressed savegame. */
+static const size_t SAVEGAME_BLOCK_SIZE = 4 * 1024 * 1024;
+/** Maximum size of the uncompressed data in a block we accept when loading, to not allocate absurd amounts for broken savegames. */
+static const size_t SAVEGAME_MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+/** Filter writing into a buffer in memory. */
+struct MemorySaveFilter : SaveFilter {
+	std::vector<uint8_t> &buffer; ///< The buffer to write to.
+
+	/**
+	 * Initialise this filter.
+	 * @param buffer The buffer to write to.
+	 */
+	MemorySaveFilter(std::vector<uint8_t> &buffer) : SaveFilter(nullptr), buffer(buffer)
+	{
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->buffer.insert(this->buffer.end(), buf, buf + size);
+	}
+};
+
+/** Filter reading from a buffer in memory. */
+struct MemoryLoadFilter : LoadFilter {
+	std::span<const uint8_t> buffer; ///< The data that has not been read yet.
+
+	/**
+	 * Initialise this filter.
+	 * @param buffer The buffer to read from.
+	 */
+	MemoryLoadFilter(std::span<const uint8_t> buffer) : LoadFilter(nullptr), buffer(buffer)
+	{
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size = std::min(size, this->buffer.size());
+		std::copy_n(this->buffer.begin(), size, buf);
+		this->buffer = this->buffer.subspan(size);
+		return size;
+	}
+
+	std::optional<std::span<const uint8_t>> ReadSpan(size_t len) override
+	{
+		std::span<const uint8_t> span = this->buffer.first(std::min(len, this->buffer.size()));
+		this->buffer = this->buffer.subspan(span.size());
+		return span;
+	}
+
+	void Reset() override
+	{
+		NOT_REACHED();
+	}
+};
+
+/**
+ * Filter splitting the savegame into blocks which are compressed independently
+ * of each other, so they can be decompressed in parallel when loading.
+ * The stream starts with the tag of the compression format of the blocks.
+ * Each block is prefixed with its uncompressed and compressed size, the
+ * stream is terminated by a block with an uncompressed size of 0.
+ */
+struct BlockSaveFilter : SaveFilter {
+	const SaveLoadFormat &format; ///< The format to compress the blocks with.
+	uint8_t compression_level; ///< The compression level to compress the blocks with.
+	std::vector<uint8_t> block; ///< Uncompressed data of the current block.
+	std::vector<uint8_t> compressed; ///< Compressed data of the current block.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param format            The format to compress the blocks with.
+	 * @param compression_level The requested level of compression.
+	 */
+	BlockSaveFilter(std::shared_ptr<SaveFilter> chain, const SaveLoadFormat &format, uint8_t compression_level) : SaveFilter(std::move(chain)), format(format), compression_level(compression_level)
+	{
+		uint32_t tag = format.tag;
+		this->chain->Write(reinterpret_cast<uint8_t *>(&tag), sizeof(tag));
+		this->block.reserve(SAVEGAME_BLOCK_SIZE);
+	}
+
+	/** Compress the current block and write it to the chain. */
+	void WriteBlock()
+	{
+		this->compressed.clear();
+		std::shared_ptr<SaveFilter> sf = this->format.init_write(std::make_shared<MemorySaveFilter>(this->compressed), this->compression_level);
+		sf->Write(this->block.data(), this->block.size());
+		sf->Finish();
+
+		uint32_t hdr[2] = { TO_BE32(static_cast<uint32_t>(this->block.size())), TO_BE32(static_cast<uint32_t>(this->compressed.size())) };
+		this->chain->Write(reinterpret_cast<uint8_t *>(hdr), sizeof(hdr));
+		this->chain->Write(this->compressed.data(), this->compressed.size());
+		this->block.clear();
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		while (size > 0) {
+			size_t to_write = std::min(size, SAVEGAME_BLOCK_SIZE - this->block.size());
+			this->block.insert(this->block.end(), buf, buf + to_write);
+			buf += to_write;
+			size -= to_write;
+
+			if (this->block.size() == SAVEGAME_BLOCK_SIZE) this->WriteBlock();
+		}
+	}
+
+	void Finish() override
+	{
+		if (!this->block.empty()) this->WriteBlock();
+
+		uint32_t terminator[2] = { 0, 0 };
+		this->chain->Write(reinterpret_cast<uint8_t *>(terminator), sizeof(terminator));
+		this->chain->Finish();
+	}
+};
+
+/**
+ * Filter reading a savegame written by #BlockSaveFilter. Blocks are read
+ * ahead of the consumer and decompressed by worker threads.
+ */
+struct BlockLoadFilter : LoadFilter {
+	/** A block of the savegame. */
+	struct Block {
+		std::vector<uint8_t> compressed{}; ///< Compressed data of the block.
+		std::vector<uint8_t> data{}; ///< Uncompressed data of the block.
+		bool done = false; ///< Whether decompressing has finished; guarded by #BlockLoadFilter::lock.
+		StringID error_str = INVALID_STRING_ID; ///< The error that occurred while decompressing, if any.
+		std::string extra_msg{}; ///< Extra error message that occurred while decompressing.
+	};
+
+	const SaveLoadFormat *format = nullptr; ///< The format the blocks are compressed with.
+	std::deque<std::unique_ptr<Block>> blocks{}; ///< Blocks that have been read but not yet consumed, in savegame order.
+	size_t pos = 0; ///< Position of the consumer in the first block.
+	bool end = false; ///< Whether the terminating block has been read.
+	size_t max_blocks = 1; ///< Number of blocks to read ahead.
+
+	std::mutex lock{}; ///< Lock for the queue and the done state of the blocks.
+	std::condition_variable work_available{}; ///< Signalled when blocks are queued for decompression.
+	std::condition_variable work_done{}; ///< Signalled when a block has been decompressed.
+	std::deque<Block *> queue{}; ///< Blocks waiting to be decompressed.
+	bool stop = false; ///< Whether the workers should stop.
+	std::vector<std::thread> threads{}; ///< Worker threads decompressing the blocks.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	BlockLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(std::move(chain))
+	{
+		uint32_t tag;
+		this->ReadFromChain(reinterpret_cast<uint8_t *>(&tag), sizeof(tag));
+
+		auto fmt = std::ranges::find(_saveload_formats, tag, &SaveLoadFormat::tag);
+		if (fmt == std::end(_saveload_formats) || fmt->tag == SAVEGAME_TAG_BLOCKS || fmt->tag == SAVEGAME_TAG_DELTA) SlErrorCorrupt("Unknown compression format of savegame blocks");
+		if (fmt->init_load == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("Loader for '{}' is not available.", fmt->name));
+		this->format = &*fmt;
+
+		/* The consumer decompresses nothing itself, so use a worker for every core. */
+		uint num_threads = std::min(std::thread::hardware_concurrency(), 8U);
+		if (num_threads > 1) {
+			for (uint i = 0; i < num_threads; i++) {
+				std::thread thread;
+				if (!StartNewThread(&thread, "ottd:loadblock", [this]() { this->WorkerLoop(); })) break;
+				this->threads.push_back(std::move(thread));
+			}
+		}
+		this->max_blocks = std::max<size_t>(1, this->threads.size() * 2);
+		Debug(sl, 2, "Loading {} compressed blocks using {} threads", fmt->name, this->threads.size());
+	}
+
+	/** Stop the workers. */
+	~BlockLoadFilter() override
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->stop = true;
+		}
+		this->work_available.notify_all();
+		for (std::thread &thread : this->threads) thread.join();
+	}
+
+	/**
+	 * Read exactly the given number of bytes from the chain.
+	 * @param buf The buffer to read into.
+	 * @param size The number of bytes to read.
+	 */
+	void ReadFromChain(uint8_t *buf, size_t size)
+	{
+		while (size > 0) {
+			size_t read = this->chain->Read(buf, size);
+			if (read == 0) SlErrorCorrupt("Unexpected end of savegame blocks");
+			buf += read;
+			size -= read;
+		}
+	}
+
+	/**
+	 * Decompress a block. This is called from the worker threads, so it uses
+	 * saveload parameters of its own and reports errors via the block.
+	 * @param block The block to decompress.
+	 */
+	void Decompress(Block &block)
+	{
+		SaveLoadParams params{};
+		params.action = SLA_NULL;
+		SaveLoadParams *old_sl = _sl;
+		_sl = &params;
+
+		try {
+			std::shared_ptr<LoadFilter> lf = this->format->init_load(std::make_shared<MemoryLoadFilter>(block.compressed));
+			size_t read = 0;
+			while (read < block.data.size()) {
+				size_t n = lf->Read(block.data.data() + read, block.data.size() - read);
+				if (n == 0) SlErrorCorrupt("Savegame block is too short");
+				read += n;
+			}
+		} catch (...) {
+			block.error_str = params.error_str;
+			block.extra_msg = params.extra_msg;
+		}
+		block.compressed = {};
+
+		_sl = old_sl;
+	}
+
+	/** Main loop of the worker threads. */
+	void WorkerLoop()
+	{
+		std::unique_lock<std::mutex> guard(this->lock);
+		for (;;) {
+			this->work_available.wait(guard, [this]() { return this->stop || !this->queue.empty(); });
+			if (this->stop) return;
+
+			Block *block = this->queue.front();
+			this->queue.pop_front();
+
+			guard.unlock();
+			this->Decompress(*block);
+			guard.lock();
+
+			block->done = true;
+			this->work_done.notify_all();
+		}
+	}
+
+	/** Read blocks from the chain until enough blocks are read ahead. */
+	void ReadAhead()
+	{
+		while (!this->end && this->blocks.size() < this->max_blocks) {
+			uint32_t hdr[2];
+			this->ReadFromChain(reinterpret_cast<uint8_t *>(hdr), sizeof(hdr));
+			size_t size = FROM_BE32(hdr[0]);
+			size_t compressed_size = FROM_BE32(hdr[1]);
+			if (size == 0) {
+				this->end = true;
+				break;
+			}
+			if (size > SAVEGAME_MAX_BLOCK_SIZE || compressed_size > SAVEGAME_MAX_BLOCK_SIZE) SlErrorCorrupt("Savegame block is too large");
+
+			auto block = std::make_unique<Block>();
+			block->compressed.resize(compressed_size);
+			this->ReadFromChain(block->compressed.data(), compressed_size);
+			block->data.resize(size);
+
+			if (this->threads.empty()) {
+				this->Decompress(*block);
+				block->done = true;
+			} else {
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->queue.push_back(block.get());
+				this->work_available.notify_one();
+			}
+			this->blocks.push_back(std::move(block));
+		}
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size_t read = 0;
+		while (read < size) {
+			this->ReadAhead();
+			if (this->blocks.empty()) break;
+
+			Block &block = *this->blocks.front();
+			if (!this->threads.empty()) {
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->work_done.wait(guard, [&block]() { return block.done; });
+			}
+			if (block.error_str != INVALID_STRING_ID) SlError(block.error_str, block.extra_msg);
+
+			size_t to_read = std::min(size - read, block.data.size() - this->pos);
+			std::copy_n(block.data.data() + this->pos, to_read, buf + read);
+			read += to_read;
+			this->pos += to_read;
+
+			if (this->pos == block.data.size()) {
+				this->blocks.pop_front();
+				this->pos = 0;
+			}
+		}
+		return read;
+	}
+
+	void Reset() override
+	{
+		NOT_REACHED();
+	}
+};
+
+/**
+ * Create a filter to load a block compressed savegame.
+ * @param chain The next filter in this chain.
+ * @return The created load filter.
+ */
+static std::shared_ptr<LoadFilter> CreateBlockLoadFilter(std::shared_ptr<LoadFilter> chain)
+{
+	return std::make_shared<BlockLoadFilter>(std::move(chain));
+}
+
+/********************************************
+ ******* START OF DIFFERENTIAL CODE *********
+ ********************************************/
+
+/** Records in the uncompressed data of a differential autosave. */
+enum DeltaRecord : uint8_t {
+	DELTA_END = 0, ///< End of the savegame.
+	DELTA_LITERAL = 1, ///< Bytes of the savegame itself; followed by a 32 bits size and the bytes.
+	DELTA_COPY = 2, ///< Bytes to copy from the full autosave; followed by a 64 bits offset and a 32 bits size.
+};
+
+/** The full autosave differential autosaves refer to. */
+struct DeltaBase {
+	std::string name; ///< File name of the full autosave, relative to the autosave directory.
+	uint64_t hash = 0; ///< Hash of the uncompressed full autosave.
+	size_t size = 0; ///< Number of uncompressed bytes of the full autosave.
+	std::vector<ChunkDigest> chunks{}; ///< The chunks of the full autosave.
+	uint deltas = 0; ///< Number of differential autosaves made against it.
+};
+
+static std::optional<DeltaBase> _delta_base; ///< The full autosave to make differential autosaves against, if any.
+static std::optional<DeltaBase> _delta_base_pending; ///< What #_delta_base becomes when the autosave in progress succeeds.
+
+/**
+ * Write a big endian 32 bits integer into a dumper.
+ * @param dumper The dumper to write to.
+ * @param value The value to write.
+ */
+static void DeltaWriteUint32(MemoryDumper &dumper, uint32_t value)
+{
+	for (int shift = 24; shift >= 0; shift -= 8) dumper.WriteByte(GB(value, shift, 8));
+}
+
+/**
+ * Write a big endian 64 bits integer into a dumper.
+ * @param dumper The dumper to write to.
+ * @param value The value to write.
+ */
+static void DeltaWriteUint64(MemoryDumper &dumper, uint64_t value)
+{
+	DeltaWriteUint32(dumper, static_cast<uint32_t>(value >> 32));
+	DeltaWriteUint32(dumper, static_cast<uint32_t>(value));
+}
+
+/**
+ * Replace the savegame in the dumper by its differences to a full autosave.
+ * Chunks that are exactly the same as in the full autosave are replaced by
+ * a reference to them, all other data is written as is.
+ * @param base The full autosave to refer to.
+ * @param chunks The chunks of the savegame in the dumper.
+ */
+static void MakeDifferentialSave(const DeltaBase &base, const std::vector<ChunkDigest> &chunks)
+{
+	auto delta = std::make_unique<MemoryDumper>();
+	DeltaWriteUint32(*delta, static_cast<uint32_t>(base.name.size()));
+	delta->Write(reinterpret_cast<const uint8_t *>(base.name.data()), base.name.size());
+	DeltaWriteUint64(*delta, base.hash);
+	DeltaWriteUint64(*delta, base.size);
+
+	auto write_literal = [&delta](size_t offset, size_t size) {
+		if (size == 0) return;
+		delta->WriteByte(DELTA_LITERAL);
+		DeltaWriteUint32(*delta, static_cast<uint32_t>(size));
+		_sl->dumper->CopyTo(offset, size, *delta);
+	};
+
+	size_t copied = 0;
+	size_t end_of_chunks = 0;
+	for (const ChunkDigest &chunk : chunks) {
+		end_of_chunks = chunk.offset + chunk.size;
+
+		auto it = std::ranges::find_if(base.chunks, [&chunk](const ChunkDigest &c) { return c.id == chunk.id && c.size == chunk.size && c.hash == chunk.hash; });
+		if (it == base.chunks.end()) {
+			write_literal(chunk.offset, chunk.size);
+			continue;
+		}
+
+		delta->WriteByte(DELTA_COPY);
+		DeltaWriteUint64(*delta, it->offset);
+		DeltaWriteUint32(*delta, static_cast<uint32_t>(chunk.size));
+		copied += chunk.size;
+	}
+	/* Whatever follows the chunks, i.e. the terminator. */
+	write_literal(end_of_chunks, _sl->dumper->GetSize() - end_of_chunks);
+	delta->WriteByte(DELTA_END);
+
+	Debug(sl, 1, "Differential autosave refers to {} of {} bytes in '{}'", copied, _sl->dumper->GetSize(), base.name);
+
+	_sl->dumper = std::move(delta);
+	_sl->differential = true;
+}
+
+/**
+ * Turn the autosave in the dumper into a differential one when possible,
+ * otherwise remember it as the full autosave for the next ones.
+ * @param name The file name of the autosave, relative to the autosave directory.
+ * @param chunks The chunks of the autosave.
+ */
+static void PrepareDifferentialAutosave(std::string_view name, std::vector<ChunkDigest> &&chunks)
+{
+	/* Make a full autosave periodically, and when the previous one is about to be overwritten. */
+	if (_delta_base.has_value() && _delta_base->deltas < _autosave_differential && _delta_base->name != name) {
+		MakeDifferentialSave(*_delta_base, chunks);
+		_delta_base_pending = _delta_base;
+		_delta_base_pending->deltas++;
+		return;
+	}
+
+	_delta_base_pending = DeltaBase{std::string{name}, _sl->dumper->Hash(), _sl->dumper->GetSize(), std::move(chunks), 0};
+}
+
+/**
+ * Read exactly the given number of bytes from a filter.
+ * @param filter The filter to read from.
+ * @param buf The buffer to read into.
+ * @param size The number of bytes to read.
+ */
+static void DeltaReadExactly(LoadFilter &filter, uint8_t *buf, size_t size)
+{
+	while (size > 0) {
+		size_t read = filter.Read(buf, size);
+		if (read == 0) SlErrorCorrupt("Unexpected end of differential savegame");
+		buf += read;
+		size -= read;
+	}
+}
+
+/**
+ * Read a big endian integer from a filter.
+ * @tparam T The type of the integer.
+ * @param filter The filter to read from.
+ * @return The read value.
+ */
+template <typename T>
+static T DeltaReadInteger(LoadFilter &filter)
+{
+	uint8_t buf[sizeof(T)];
+	DeltaReadExactly(filter, buf, sizeof(buf));
+
+	T value = 0;
+	for (uint8_t b : buf) value = (value << 8) | b;
+	return value;
+}
+
+/**
+ * Find the format of a savegame a differential savegame consists of.
+ * @param tag The tag of the format.
+ * @return The format.
+ */
+static const SaveLoadFormat &GetDeltaInnerFormat(uint32_t tag)
+{
+	auto fmt = std::ranges::find(_saveload_formats, tag, &SaveLoadFormat::tag);
+	if (fmt == std::end(_saveload_formats) || fmt->tag == SAVEGAME_TAG_DELTA) SlErrorCorrupt("Unknown compression format of differential savegame");
+	if (fmt->init_load == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("Loader for '{}' is not available.", fmt->name));
+	return *fmt;
+}
+
+/**
+ * Load the uncompressed data of the full autosave of a differential savegame.
+ * @param name The file name of the full autosave, relative to the autosave directory.
+ * @param hash The expected hash of the data.
+ * @param size The expected size of the data.
+ * @return The uncompressed data.
+ */
+static std::vector<uint8_t> LoadDeltaBase(const std::string &name, uint64_t hash, size_t size)
+{
+	auto fh = FioFOpenFile(name, "rb", Subdirectory::Autosave);
+	if (!fh.has_value()) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE, fmt::format("Full autosave '{}' of differential savegame not found.", name));
+
+	std::shared_ptr<LoadFilter> reader = CreateFileReader(std::move(*fh));
+	uint32_t hdr[2];
+	DeltaReadExactly(*reader, reinterpret_cast<uint8_t *>(hdr), sizeof(hdr));
+	if ((FROM_BE32(hdr[1]) >> 16) != _sl_version) SlErrorCorrupt("Full autosave of differential savegame has a different version");
+
+	reader = GetDeltaInnerFormat(hdr[0]).init_load(reader);
+
+	std::vector<uint8_t> data(size);
+	DeltaReadExactly(*reader, data.data(), data.size());
+	if (HashBytes(0, data) != hash) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_SAVEGAME, fmt::format("Full autosave '{}' of differential savegame has been overwritten.", name));
+	return data;
+}
+
+/** Filter reconstructing a differential autosave from its full autosave. */
+struct DeltaLoadFilter : LoadFilter {
+	std::vector<uint8_t> data{}; ///< The reconstructed uncompressed savegame.
+	size_t pos = 0; ///< Position of the next byte to read.
+
+	/**
+	 * Initialise this filter, and reconstruct the savegame.
+	 * @param chain The next filter in this chain.
+	 */
+	DeltaLoadFilter(std::shared_ptr<LoadFilter> chain) : LoadFilter(std::move(chain))
+	{
+		uint32_t tag;
+		DeltaReadExactly(*this->chain, reinterpret_cast<uint8_t *>(&tag), sizeof(tag));
+		std::shared_ptr<LoadFilter> payload = GetDeltaInnerFormat(tag).init_load(this->chain);
+
+		uint32_t name_length = DeltaReadInteger<uint32_t>(*payload);
+		if (name_length > MAX_PATH) SlErrorCorrupt("Invalid name of full autosave in differential savegame");
+		std::string name(name_length, '\0');
+		DeltaReadExactly(*payload, reinterpret_cast<uint8_t *>(name.data()), name.size());
+		uint64_t hash = DeltaReadInteger<uint64_t>(*payload);
+		uint64_t size = DeltaReadInteger<uint64_t>(*payload);
+
+		std::vector<uint8_t> base = LoadDeltaBase(name, hash, size);
+
+		for (;;) {
+			switch (DeltaReadInteger<uint8_t>(*payload)) {
+				case DELTA_END:
+					Debug(sl, 1, "Reconstructed {} bytes of differential savegame from '{}'", this->data.size(), name);
+					return;
+
+				case DELTA_LITERAL: {
+					uint32_t length = DeltaReadInteger<uint32_t>(*payload);
+					size_t start = this->data.size();
+					this->data.resize(start + length);
+					DeltaReadExactly(*payload, this->data.data() + start, length);
+					break;
+				}
+
+				case DELTA_COPY: {
+					uint64_t offset = DeltaReadInteger<uint64_t>(*payload);
+					uint32_t length = DeltaReadInteger<uint32_t>(*payload);
+					if (offset > base.size() || length > base.size() - offset) SlErrorCorrupt("Differential savegame refers outside of its full autosave");
+					this->data.insert(this->data.end(), base.begin() + offset, base.begin() + offset + length);
+					break;
+				}
+
+				default:
+					SlErrorCorrupt("Unknown record in differential savegame");
+			}
+		}
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size_t len = std::min(size, this->data.size() - this->pos);
+		std::copy_n(this->data.data() + this->pos, len, buf);
+		this->pos += len;
+		return len;
+	}
+
+	std::optional<std::span<const uint8_t>> ReadSpan(size_t len) override
+	{
+		std::span<const uint8_t> span{this->data.data() + this->pos, std::min(len, this->data.size() - this->pos)};
+		this->pos += span.size();
+		return span;
+	}
+
+	void Reset() override
+	{
+		this->pos = 0;
+	}
 };
 
+/**
+ * Create the filter for loading a differential savegame.
+ * @param chain The next filter in this chain.
+ * @return The created load filter.
+ */
+static std::shared_ptr<LoadFilter> CreateDeltaLoadFilter(std::shared_ptr<LoadFilter> chain)
+{
+	return std::make_shared<DeltaLoadFilter>(std::move(chain));
+}
+
 /**
  * Return the savegameformat of the game. Whether it was created with ZLIB compression
  * uncompressed, or another type
@@ -2871,8 +4144,9 @@ static const SaveLoadFormat _saveload_formats[] = {
  */
 static std::pair<const SaveLoadFormat &, uint8_t> GetSavegameFormat(std::string_view full_name)
 {
-	/* Find default savegame format, the highest one with which files can be written. */
-	auto it = std::find_if(std::rbegin(_saveload_formats), std::rend(_saveload_formats), [](const auto &slf) { return slf.init_write != nullptr; });
+	/* Find default savegame format, the highest one with which files can be written.
+	 * Zstandard is skipped, as older versions cannot load it. */
+	auto it = std::find_if(std::rbegin(_saveload_formats), std::rend(_saveload_formats), [](const auto &slf) { return slf.init_write != nullptr && slf.tag != SAVEGAME_TAG_ZSTD; });
 	if (it == std::rend(_saveload_formats)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "no writeable savegame formats");
 
 	const SaveLoadFormat &def = *it;
@@ -2952,10 +4226,11 @@ static void ResetSaveloadData()
  */
 static inline void ClearSaveLoadState()
 {
-	_sl.dumper = nullptr;
-	_sl.sf = nullptr;
-	_sl.reader = nullptr;
-	_sl.lf = nullptr;
+	_sl->dumper = nullptr;
+	_sl->sf = nullptr;
+	_sl->reader = nullptr;
+	_sl->lf = nullptr;
+	_sl->differential = false;
 }
 
 /** Update the gui accordingly when starting saving and set locks on saveload. */
@@ -2964,7 +4239,7 @@ static void SaveFileStart()
 	SetMouseCursorBusy(true);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_START);
-	_sl.saveinprogress = true;
+	_sl->saveinprogress = true;
 }
 
 /** Update the gui accordingly when saving is done and release locks on saveload. */
@@ -2973,7 +4248,17 @@ static void SaveFileDone()
 	SetMouseCursorBusy(false);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_FINISH);
-	_sl.saveinprogress = false;
+	_sl->saveinprogress = false;
+
+	bool success = _save_profile_pending.valid;
+	if (success && _sl->keep_profile) _save_profile = std::move(_save_profile_pending);
+	_save_profile_pending = {};
+
+	/* Only refer to autosaves that have been written completely. */
+	if (_delta_base_pending.has_value()) {
+		_delta_base = success ? std::move(_delta_base_pending) : std::nullopt;
+		_delta_base_pending.reset();
+	}
 
 #ifdef __EMSCRIPTEN__
 	EM_ASM(if (window["openttd_syncfs"]) openttd_syncfs());
@@ -2986,7 +4271,7 @@ static void SaveFileDone()
  */
 void SetSaveLoadError(StringID str)
 {
-	_sl.error_str = str;
+	_sl->error_str = str;
 }
 
 /**
@@ -2995,7 +4280,7 @@ void SetSaveLoadError(StringID str)
  */
 EncodedString GetSaveLoadErrorType()
 {
-	return GetEncodedString(_sl.action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED);
+	return GetEncodedString(_sl->action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED);
 }
 
 /**
@@ -3004,7 +4289,7 @@ EncodedString GetSaveLoadErrorType()
  */
 EncodedString GetSaveLoadErrorMessage()
 {
-	return GetEncodedString(_sl.error_str, _sl.extra_msg);
+	return GetEncodedString(_sl->error_str, _sl->extra_msg);
 }
 
 /** Show a gui message when saving has failed */
@@ -3014,6 +4299,72 @@ static void SaveFileError()
 	SaveFileDone();
 }
 
+/**
+ * Estimate the compressed size of each chunk. Compressors buffer data
+ * internally, so this is only an approximation; the compressed size is
+ * interpolated linearly between the points where it has been measured.
+ * @param profile The profile with the chunks to update.
+ * @param marks Pairs of number of uncompressed bytes and number of compressed bytes written at that point, sorted.
+ */
+static void UpdateCompressedChunkSizes(SaveLoadProfile &profile, const std::vector<std::pair<size_t, size_t>> &marks)
+{
+	auto compressed_at = [&marks](size_t offset) -> size_t {
+		auto it = std::ranges::lower_bound(marks, offset, {}, &std::pair<size_t, size_t>::first);
+		if (it == marks.end()) return marks.back().second;
+		if (it == marks.begin() || it->first == offset) return it->second;
+
+		auto prev = std::prev(it);
+		return prev->second + (it->second - prev->second) * (offset - prev->first) / (it->first - prev->first);
+	};
+
+	for (SaveLoadChunkProfile &chunk : profile.chunks) {
+		chunk.compressed_size = compressed_at(chunk.offset + chunk.size) - compressed_at(chunk.offset);
+	}
+}
+
+/**
+ * Compress the game that has been written into memory and write it to the
+ * save filter, filling in the pending profile. This does not touch the gui,
+ * errors are thrown like SlError does.
+ * @param fmt The format to compress the savegame with.
+ * @param compression The compression level to use.
+ */
+static void WriteSavegame(const SaveLoadFormat &fmt, uint8_t compression)
+{
+	/* We have written our stuff to memory, now write it to file! */
+	bool blocks = _savegame_block_compression && !_sl->differential;
+	uint32_t hdr[2] = { _sl->differential ? SAVEGAME_TAG_DELTA : (blocks ? SAVEGAME_TAG_BLOCKS : fmt.tag), TO_BE32(SAVEGAME_VERSION << 16) };
+	_sl->sf->Write((uint8_t*)hdr, sizeof(hdr));
+	if (_sl->differential) {
+		uint32_t tag = fmt.tag;
+		_sl->sf->Write((uint8_t*)&tag, sizeof(tag));
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	auto counter = std::make_shared<CountingSaveFilter>(_sl->sf);
+	if (blocks) {
+		_sl->sf = std::make_shared<BlockSaveFilter>(counter, fmt, compression);
+	} else {
+		_sl->sf = fmt.init_write(counter, compression);
+	}
+
+	/* Remember how much compressed data has been written after each block, to attribute it to the chunks. */
+	std::vector<std::pair<size_t, size_t>> marks{{0, 0}};
+	_sl->dumper->Flush(_sl->sf, [&marks, &counter](size_t size) { marks.emplace_back(size, counter->written); });
+	marks.back().second = counter->written;
+
+	SaveLoadProfile &profile = _save_profile_pending;
+	profile.format = blocks ? fmt::format("{} blocks", fmt.name) : (_sl->differential ? fmt::format("{} differential", fmt.name) : std::string{fmt.name});
+	profile.size = _sl->dumper->GetSize();
+	profile.compressed_size = sizeof(hdr) + counter->written;
+	profile.write_time = std::chrono::steady_clock::now() - start;
+	profile.valid = true;
+	/* The chunks of a differential savegame are not in the dumper. */
+	if (!_sl->differential) UpdateCompressedChunkSizes(profile, marks);
+	Debug(sl, 1, "Compressed {} bytes into {} bytes using {} in {} us", profile.size, profile.compressed_size, profile.format,
+		std::chrono::duration_cast<std::chrono::microseconds>(profile.write_time).count());
+}
+
 /**
  * We have written the whole game into memory, _memory_savegame, now find
  * and appropriate compressor and start writing to file.
@@ -3024,14 +4375,7 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
 	try {
 		auto [fmt, compression] = GetSavegameFormat(_savegame_format);
-
-		/* We have written our stuff to memory, now write it to file! */
-		uint32_t hdr[2] = { fmt.tag, TO_BE32(SAVEGAME_VERSION << 16) };
-		_sl.sf->Write((uint8_t*)hdr, sizeof(hdr));
-
-		_sl.sf = fmt.init_write(_sl.sf, compression);
-		_sl.dumper->Flush(_sl.sf);
-
+		WriteSavegame(fmt, compression);
 		ClearSaveLoadState();
 
 		if (threaded) SetAsyncSaveFinish(SaveFileDone);
@@ -3044,7 +4388,7 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 
 		/* We don't want to shout when saving is just
 		 * cancelled due to a client disconnecting. */
-		if (_sl.error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
+		if (_sl->error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
 			/* Skip the "colour" character */
 			Debug(sl, 0, "{}", GetSaveLoadErrorType().GetDecodedString().substr(3) + GetSaveLoadErrorMessage().GetDecodedString());
 			asfp = SaveFileError;
@@ -3059,8 +4403,365 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 	}
 }
 
+#if defined(__linux__)
+static pid_t _snapshot_pid = -1; ///< Process writing the current snapshot savegame, or -1 when there is none.
+static int _snapshot_fd = -1; ///< Read end of the pipe the snapshot process reports its results through, or -1 when there is none.
+static std::string _snapshot_result; ///< What has been read from #_snapshot_fd so far.
+static std::chrono::steady_clock::time_point _snapshot_start; ///< When the current snapshot process was forked.
+
+/**
+ * Write a string to the results of the snapshot process.
+ * @param builder The results to write to.
+ * @param str The string to write.
+ */
+static void SnapshotPutString(StringBuilder &builder, std::string_view str)
+{
+	builder.PutUint32LE(static_cast<uint32_t>(str.size()));
+	builder.Put(str);
+}
+
+/**
+ * Read a string from the results of the snapshot process.
+ * @param consumer The results to read from.
+ * @return The string.
+ */
+static std::string SnapshotReadString(StringConsumer &consumer)
+{
+	return std::string{consumer.Read(consumer.ReadUint32LE())};
+}
+
+/**
+ * Encode what the parent process needs to know about the save made by the
+ * snapshot process, i.e. its profile and the autosave differential
+ * autosaves can refer to.
+ * @return The encoded results.
+ */
+static std::string EncodeSnapshotResult()
+{
+	std::string result;
+	StringBuilder builder(result);
+
+	const SaveLoadProfile &profile = _save_profile_pending;
+	builder.PutUint8(profile.valid);
+	SnapshotPutString(builder, profile.format);
+	builder.PutUint64LE(profile.size);
+	builder.PutUint64LE(profile.compressed_size);
+	builder.PutUint64LE(profile.chunks_time.count());
+	builder.PutUint64LE(profile.write_time.count());
+	builder.PutUint32LE(static_cast<uint32_t>(profile.chunks.size()));
+	for (const SaveLoadChunkProfile &chunk : profile.chunks) {
+		SnapshotPutString(builder, chunk.name);
+		builder.PutUint64LE(chunk.offset);
+		builder.PutUint64LE(chunk.size);
+		builder.PutUint64LE(chunk.compressed_size);
+		builder.PutUint64LE(chunk.time.count());
+	}
+
+	builder.PutUint8(_delta_base_pending.has_value());
+	if (_delta_base_pending.has_value()) {
+		const DeltaBase &base = *_delta_base_pending;
+		SnapshotPutString(builder, base.name);
+		builder.PutUint64LE(base.hash);
+		builder.PutUint64LE(base.size);
+		builder.PutUint32LE(base.deltas);
+		builder.PutUint32LE(static_cast<uint32_t>(base.chunks.size()));
+		for (const ChunkDigest &chunk : base.chunks) {
+			builder.PutUint32LE(chunk.id);
+			builder.PutUint64LE(chunk.offset);
+			builder.PutUint64LE(chunk.size);
+			builder.PutUint64LE(chunk.hash);
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Encode the error the snapshot process ran into, so the parent can report
+ * it like the error of a threaded save.
+ * @return The encoded error.
+ */
+static std::string EncodeSnapshotError()
+{
+	std::string result;
+	StringBuilder builder(result);
+	builder.PutUint32LE(_sl->error_str);
+	SnapshotPutString(builder, _sl->extra_msg);
+	return result;
+}
+
+/**
+ * Write the results of the snapshot process to the pipe to the parent.
+ * The size is prefixed, so the parent can tell whether it got everything.
+ * @param fd The write end of the pipe.
+ * @param result The results as encoded by #EncodeSnapshotResult or #EncodeSnapshotError.
+ */
+static void WriteSnapshotResult(int fd, std::string_view result)
+{
+	std::string framed;
+	StringBuilder builder(framed);
+	builder.PutUint32LE(static_cast<uint32_t>(result.size()));
+	builder.Put(result);
+
+	std::string_view remaining = framed;
+	while (!remaining.empty()) {
+		ssize_t len = write(fd, remaining.data(), remaining.size());
+		if (len < 0 && errno == EINTR) continue;
+		if (len <= 0) break;
+		remaining.remove_prefix(len);
+	}
+}
+
+/**
+ * Decode the results of the snapshot process into the pending profile and
+ * autosave, so #SaveFileDone handles them like those of a threaded save.
+ * @param result The results as encoded by #EncodeSnapshotResult.
+ * @return True when the results are complete.
+ */
+static bool DecodeSnapshotResult(std::string_view result)
+{
+	StringConsumer consumer(result);
+	if (consumer.ReadUint32LE() != consumer.GetBytesLeft()) return false;
+
+	SaveLoadProfile profile;
+	profile.valid = consumer.ReadUint8() != 0;
+	profile.format = SnapshotReadString(consumer);
+	profile.size = consumer.ReadUint64LE();
+	profile.compressed_size = consumer.ReadUint64LE();
+	profile.chunks_time = std::chrono::steady_clock::duration{consumer.ReadUint64LE()};
+	profile.write_time = std::chrono::steady_clock::duration{consumer.ReadUint64LE()};
+	for (uint32_t count = consumer.ReadUint32LE(); count > 0 && consumer.AnyBytesLeft(); count--) {
+		SaveLoadChunkProfile &chunk = profile.chunks.emplace_back();
+		chunk.name = SnapshotReadString(consumer);
+		chunk.offset = consumer.ReadUint64LE();
+		chunk.size = consumer.ReadUint64LE();
+		chunk.compressed_size = consumer.ReadUint64LE();
+		chunk.time = std::chrono::steady_clock::duration{consumer.ReadUint64LE()};
+	}
+
+	std::optional<DeltaBase> delta_base;
+	if (consumer.ReadUint8() != 0) {
+		DeltaBase &base = delta_base.emplace();
+		base.name = SnapshotReadString(consumer);
+		base.hash = consumer.ReadUint64LE();
+		base.size = consumer.ReadUint64LE();
+		base.deltas = consumer.ReadUint32LE();
+		for (uint32_t count = consumer.ReadUint32LE(); count > 0 && consumer.AnyBytesLeft(); count--) {
+			uint32_t id = consumer.ReadUint32LE();
+			size_t offset = consumer.ReadUint64LE();
+			size_t size = consumer.ReadUint64LE();
+			base.chunks.emplace_back(id, offset, size, consumer.ReadUint64LE());
+		}
+	}
+
+	/* Anything left over means the results got mangled; better not use them. */
+	if (consumer.AnyBytesLeft()) return false;
+
+	_save_profile_pending = std::move(profile);
+	_delta_base_pending = std::move(delta_base);
+	return true;
+}
+
+/**
+ * Decode the error reported by the snapshot process into the saveload state,
+ * so #SaveFileError shows it like the error of a threaded save.
+ * @param result The error as encoded by #EncodeSnapshotError.
+ * @return True when the error is complete.
+ */
+static bool DecodeSnapshotError(std::string_view result)
+{
+	StringConsumer consumer(result);
+	if (consumer.ReadUint32LE() != consumer.GetBytesLeft()) return false;
+
+	StringID error_str = consumer.ReadUint32LE();
+	std::string extra_msg = SnapshotReadString(consumer);
+	if (consumer.AnyBytesLeft()) return false;
+
+	_sl->error_str = error_str;
+	_sl->extra_msg = std::move(extra_msg);
+	return true;
+}
+
+/**
+ * Read what the snapshot process has written to the pipe so far.
+ * @param wait Whether to block until the snapshot process closed the pipe.
+ */
+static void ReadSnapshotResult(bool wait)
+{
+	if (_snapshot_fd < 0) return;
+
+	if (wait) fcntl(_snapshot_fd, F_SETFL, fcntl(_snapshot_fd, F_GETFL) & ~O_NONBLOCK);
+
+	char buf[4096];
+	for (;;) {
+		ssize_t len = read(_snapshot_fd, buf, sizeof(buf));
+		if (len > 0) {
+			_snapshot_result.append(buf, len);
+			continue;
+		}
+		if (len < 0 && errno == EINTR) continue;
+		/* Stop when the pipe is empty; at the end, or on errors, close it. */
+		if (len < 0 && errno == EAGAIN) return;
+		break;
+	}
+	close(_snapshot_fd);
+	_snapshot_fd = -1;
+}
+
+/**
+ * Save the game from a forked copy of this process. The child gets a
+ * copy-on-write image of the game state at this very moment, so it can
+ * serialise and compress it while the parent carries on running the game.
+ * Only the calling thread exists in the child, and locks held by any other
+ * thread stay locked forever, so the child does all the work synchronously
+ * on that thread. It does not touch the gui either, but reports its results
+ * or errors through a pipe and leaves via _exit() to not run any of the
+ * parent's exit handlers or destructors.
+ * @param file The file to write the savegame to.
+ * @param autosave_name File name of the autosave when it may be differential, relative to the autosave directory.
+ * @return True when the child process has been started, false when forking failed and the caller should save normally.
+ */
+static bool StartSnapshotSave(FileHandle &file, std::string_view autosave_name)
+{
+	/* Resolve the format here, as a bad compression level is reported in the gui. */
+	auto [fmt, compression] = GetSavegameFormat(_savegame_format);
+
+	int fds[2];
+	if (pipe2(fds, O_CLOEXEC) != 0) {
+		Debug(sl, 1, "Cannot create pipe for snapshot process ({}), reverting to threaded mode...", strerror(errno));
+		return false;
+	}
+
+	/* Anything still buffered would otherwise be written by both processes. */
+	fflush(nullptr);
+
+	auto start = std::chrono::steady_clock::now();
+	pid_t pid = fork();
+	if (pid < 0) {
+		Debug(sl, 1, "Cannot fork snapshot process ({}), reverting to threaded mode...", strerror(errno));
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+
+		int status = EXIT_FAILURE;
+		std::string result;
+		try {
+			_sl->dumper = std::make_unique<MemoryDumper>();
+			_sl->sf = std::make_shared<FileWriter>(std::move(file));
+			_sl_version = SAVEGAME_VERSION;
+
+			SaveViewportBeforeSaveGame();
+			if (autosave_name.empty()) {
+				SlSaveChunks(nullptr, false);
+			} else {
+				std::vector<ChunkDigest> chunks;
+				SlSaveChunks(&chunks, false);
+				PrepareDifferentialAutosave(autosave_name, std::move(chunks));
+			}
+
+			WriteSavegame(fmt, compression);
+			result = EncodeSnapshotResult();
+			status = EXIT_SUCCESS;
+		} catch (...) {
+			result = EncodeSnapshotError();
+		}
+		WriteSnapshotResult(fds[1], result);
+		_exit(status);
+	}
+
+	close(fds[1]);
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+	Debug(sl, 2, "Forked snapshot process {} in {} us", pid, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+	_snapshot_pid = pid;
+	_snapshot_fd = fds[0];
+	_snapshot_result.clear();
+	_snapshot_start = start;
+	SaveFileStart();
+	return true;
+}
+
+/**
+ * Check whether the snapshot process has finished, and if so reap it and
+ * report the result like a threaded save would.
+ * @param wait Whether to block until the snapshot process has finished.
+ */
+static void CheckSnapshotSave(bool wait)
+{
+	if (_snapshot_pid < 0) return;
+
+	/* Empty the pipe first, so the snapshot process never blocks on writing its results. */
+	ReadSnapshotResult(wait);
+
+	int status = 0;
+	pid_t pid;
+	do {
+		pid = waitpid(_snapshot_pid, &status, wait ? 0 : WNOHANG);
+	} while (pid < 0 && errno == EINTR);
+	if (pid == 0) return;
+
+	_snapshot_pid = -1;
+	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _snapshot_start);
+
+	if (pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+		Debug(sl, 1, "Snapshot savegame written in {} ms", duration.count());
+		ReadSnapshotResult(true);
+		if (!DecodeSnapshotResult(_snapshot_result)) {
+			/* The savegame is fine, but its profile is unknown and it cannot be referred to. */
+			Debug(sl, 1, "Snapshot process did not report its results properly");
+			_save_profile_pending = {};
+			_delta_base_pending = std::nullopt;
+			_delta_base = std::nullopt;
+		}
+		_snapshot_result.clear();
+		SaveFileDone();
+		return;
+	}
+	/* Whatever got written might have been the autosave differential autosaves refer to. */
+	_delta_base.reset();
+	_save_profile_pending = {};
+	_delta_base_pending.reset();
+
+	std::string reason;
+	if (pid < 0) {
+		reason = fmt::format("cannot wait for snapshot process: {}", strerror(errno));
+	} else if (WIFSIGNALED(status)) {
+		reason = fmt::format("snapshot process killed by signal {}", WTERMSIG(status));
+	} else {
+		reason = fmt::format("snapshot process exited with status {}", WEXITSTATUS(status));
+	}
+
+	if (pid > 0 && WIFEXITED(status)) {
+		/* The child has exited, so reading up to the end of the pipe doesn't block. */
+		ReadSnapshotResult(true);
+	} else if (_snapshot_fd >= 0) {
+		close(_snapshot_fd);
+		_snapshot_fd = -1;
+	}
+
+	/* Report the error the child ran into, or how it ended when it could not tell. */
+	_sl->action = SLA_SAVE;
+	if (_snapshot_result.empty() || !DecodeSnapshotError(_snapshot_result)) {
+		_sl->error_str = STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR;
+		_sl->extra_msg = std::move(reason);
+	}
+	_snapshot_result.clear();
+
+	Debug(sl, 0, "{}", GetSaveLoadErrorType().GetDecodedString().substr(3) + GetSaveLoadErrorMessage().GetDecodedString());
+	SaveFileError();
+}
+#endif /* __linux__ */
+
 void WaitTillSaved()
 {
+#if defined(__linux__)
+	CheckSnapshotSave(true);
+#endif
+
 	if (!_save_thread.joinable()) return;
 
 	_save_thread.join();
@@ -3075,19 +4776,26 @@ void WaitTillSaved()
  * using the writer, either in threaded mode if possible, or single-threaded.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param autosave_name File name of the autosave when it may be differential, relative to the autosave directory.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded)
+static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded, std::string_view autosave_name = {})
 {
-	assert(!_sl.saveinprogress);
+	assert(!_sl->saveinprogress);
 
-	_sl.dumper = std::make_unique<MemoryDumper>();
-	_sl.sf = std::move(writer);
+	_sl->dumper = std::make_unique<MemoryDumper>();
+	_sl->sf = std::move(writer);
 
 	_sl_version = SAVEGAME_VERSION;
 
 	SaveViewportBeforeSaveGame();
-	SlSaveChunks();
+	if (autosave_name.empty()) {
+		SlSaveChunks();
+	} else {
+		std::vector<ChunkDigest> chunks;
+		SlSaveChunks(&chunks);
+		PrepareDifferentialAutosave(autosave_name, std::move(chunks));
+	}
 
 	SaveFileStart();
 
@@ -3112,7 +4820,8 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
 SaveOrLoadResult SaveWithFilter(std::shared_ptr<SaveFilter> writer, bool threaded)
 {
 	try {
-		_sl.action = SLA_SAVE;
+		_sl->action = SLA_SAVE;
+		_sl->keep_profile = false;
 		return DoSave(std::move(writer), threaded);
 	} catch (...) {
 		ClearSaveLoadState();
@@ -3148,7 +4857,7 @@ static const SaveLoadFormat *DetermineSaveLoadFormat(uint32_t tag, uint32_t raw_
 	}
 
 	Debug(sl, 0, "Unknown savegame type, trying to load it as the buggy format");
-	_sl.lf->Reset();
+	_sl->lf->Reset();
 	_sl_version = SL_MIN_VERSION;
 	_sl_minor_version = 0;
 
@@ -3171,7 +4880,7 @@ static const SaveLoadFormat *DetermineSaveLoadFormat(uint32_t tag, uint32_t raw_
  */
 static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_check)
 {
-	_sl.lf = std::move(reader);
+	_sl->lf = std::move(reader);
 
 	if (load_check) {
 		/* Clear previous check data */
@@ -3181,7 +4890,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 	}
 
 	uint32_t hdr[2];
-	if (_sl.lf->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	if (_sl->lf->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
 
 	/* see if we have any loader for this type. */
 	const SaveLoadFormat *fmt = DetermineSaveLoadFormat(hdr[0], hdr[1]);
@@ -3191,10 +4900,16 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 		SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, fmt::format("Loader for '{}' is not available.", fmt->name));
 	}
 
-	_sl.lf = fmt->init_load(_sl.lf);
-	_sl.reader = std::make_unique<ReadBuffer>(_sl.lf);
+	auto counter = std::make_shared<CountingLoadFilter>(_sl->lf);
+	_sl->lf = fmt->init_load(counter);
+	_sl->reader = std::make_unique<ReadBuffer>(_sl->lf);
 	_next_offs = 0;
 
+	if (!load_check) {
+		_load_profile_pending = {};
+		_load_profile_pending.format = fmt->name;
+	}
+
 	if (!load_check) {
 		ResetSaveloadData();
 
@@ -3239,6 +4954,8 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 		/* Load chunks and resolve references */
 		SlLoadChunks();
 		SlFixPointers();
+		_load_profile_pending.compressed_size = sizeof(hdr) + counter->read;
+		_load_profile_pending.valid = true;
 	}
 
 	ClearSaveLoadState();
@@ -3264,6 +4981,44 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 	return SL_OK;
 }
 
+/**
+ * Get the profile of the last saved game.
+ * @return The profile, which is invalid when no game has been saved yet.
+ */
+const SaveLoadProfile &GetSaveProfile()
+{
+	return _save_profile;
+}
+
+/**
+ * Get the profile of the last loaded game.
+ * @return The profile, which is invalid when no game has been loaded yet.
+ */
+const SaveLoadProfile &GetLoadProfile()
+{
+	return _load_profile;
+}
+
+/** Start timing the phases of AfterLoadGame. */
+void ResetAfterLoadProfile()
+{
+	_load_profile_pending.afterload.clear();
+	_afterload_phase_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * Record the time taken since the previous phase of AfterLoadGame.
+ * @param name The name of the phase that just ended.
+ */
+void ProfileAfterLoadPhase(std::string_view name)
+{
+	auto now = std::chrono::steady_clock::now();
+	auto &phase = _load_profile_pending.afterload.emplace_back(std::string{name}, now - _afterload_phase_start);
+	_afterload_phase_start = now;
+
+	Debug(sl, 2, "AfterLoadGame phase {} took {} us", phase.first, std::chrono::duration_cast<std::chrono::microseconds>(phase.second).count());
+}
+
 /**
  * Load the game using a (reader) filter.
  * @param reader   The filter to read the savegame from.
@@ -3272,7 +5027,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 SaveOrLoadResult LoadWithFilter(std::shared_ptr<LoadFilter> reader)
 {
 	try {
-		_sl.action = SLA_LOAD;
+		_sl->action = SLA_LOAD;
 		return DoLoad(std::move(reader), false);
 	} catch (...) {
 		ClearSaveLoadState();
@@ -3293,7 +5048,7 @@ SaveOrLoadResult LoadWithFilter(std::shared_ptr<LoadFilter> reader)
 SaveOrLoadResult SaveOrLoad(std::string_view filename, SaveLoadOperation fop, DetailedFileType dft, Subdirectory sb, bool threaded)
 {
 	/* An instance of saving is already active, so don't go saving again */
-	if (_sl.saveinprogress && fop == SaveLoadOperation::Save && dft == DetailedFileType::GameFile && threaded) {
+	if (_sl->saveinprogress && fop == SaveLoadOperation::Save && dft == DetailedFileType::GameFile && threaded) {
 		/* if not an autosave, but a user action, show error message */
 		if (!_do_autosave) ShowErrorMessage(GetEncodedString(STR_ERROR_SAVE_STILL_IN_PROGRESS), {}, WL_ERROR);
 		return SL_OK;
@@ -3328,15 +5083,15 @@ SaveOrLoadResult SaveOrLoad(std::string_view filename, SaveLoadOperation fop, De
 		assert(dft == DetailedFileType::GameFile);
 		switch (fop) {
 			case SaveLoadOperation::Check:
-				_sl.action = SLA_LOAD_CHECK;
+				_sl->action = SLA_LOAD_CHECK;
 				break;
 
 			case SaveLoadOperation::Load:
-				_sl.action = SLA_LOAD;
+				_sl->action = SLA_LOAD;
 				break;
 
 			case SaveLoadOperation::Save:
-				_sl.action = SLA_SAVE;
+				_sl->action = SLA_SAVE;
 				break;
 
 			default: NOT_REACHED();
@@ -3356,14 +5111,24 @@ SaveOrLoadResult SaveOrLoad(std::string_view filename, SaveLoadOperation fop, De
 		if (fop == SaveLoadOperation::Save) { // SAVE game
 			Debug(desync, 1, "save: {:08x}; {:02x}; {}", TimerGameEconomy::date, TimerGameEconomy::date_fract, filename);
 			if (!_settings_client.gui.threaded_saves) threaded = false;
+			_sl->keep_profile = true;
+			bool differential = _do_autosave && sb == Subdirectory::Autosave && dft == DetailedFileType::GameFile && _autosave_differential > 0;
 
-			return DoSave(std::make_shared<FileWriter>(std::move(*fh)), threaded);
+#if defined(__linux__)
+			/* Only dedicated servers, as the child cannot touch the video driver or anything else a client has running. */
+			if (threaded && _savegame_fork_snapshot && _network_dedicated && StartSnapshotSave(*fh, differential ? filename : std::string_view{})) return SL_OK;
+#endif
+
+			return DoSave(std::make_shared<FileWriter>(std::move(*fh)), threaded, differential ? filename : std::string_view{});
 		}
 
 		/* LOAD game */
 		assert(fop == SaveLoadOperation::Load || fop == SaveLoadOperation::Check);
 		Debug(desync, 1, "load: {}", filename);
-		return DoLoad(std::make_shared<FileReader>(std::move(*fh)), fop == SaveLoadOperation::Check);
+		SaveOrLoadResult result = DoLoad(CreateFileReader(std::move(*fh)), fop == SaveLoadOperation::Check);
+		/* Only keep the profile of games loaded from files, not of those received from the network or replays. */
+		if (result == SL_OK && fop == SaveLoadOperation::Load) _load_profile = std::move(_load_profile_pending);
+		return result;
 	} catch (...) {
 		/* This code may be executed both for old and new save games. */
 		ClearSaveLoadState();
@@ -14,6 +14,8 @@
 #include "../fileio_type.h"
 #include "../fios.h"
 
+#include <chrono>
+
 /** SaveLoad versions
  * Previous savegame versions, the trunk revision where they were
  * introduced and the released version that had that particular
@@ -414,6 +416,8 @@ enum SaveLoadVersion : uint16_t {
 	SLV_ENGINE_MULTI_RAILTYPE,              ///< 362  PR#14357 v15.0 Train engines can have multiple railtypes.
 	SLV_SIGN_TEXT_COLOURS,                  ///< 363  PR#14743 Configurable sign text colors in scenario editor.
 	SLV_BUOYS_AT_0_0,                       ///< 364  PR#14983 Allow to build buoys at (0x0).
+	SLV_LINKGRAPH_DEMAND_ACCELERATED,       ///< 365  Approximate demand calculation for large link graphs.
+	SLV_LINKGRAPH_ADAPTIVE_RECALC_TIME,     ///< 366  Link graph recalculation time scaled by the size of the link graph.
 
 	SL_MAX_VERSION,                         ///< Highest possible saveload version
 };
@@ -448,6 +452,30 @@ enum SavegameType : uint8_t {
 
 extern FileToSaveLoad _file_to_saveload;
 
+/** Profile of a single chunk of the last saved or loaded game. */
+struct SaveLoadChunkProfile {
+	std::string name; ///< Name of the chunk.
+	size_t offset = 0; ///< Offset of the chunk in the uncompressed savegame.
+	size_t size = 0; ///< Number of uncompressed bytes of the chunk.
+	size_t compressed_size = 0; ///< Approximate number of compressed bytes of the chunk; only known when saving.
+	std::chrono::steady_clock::duration time{}; ///< Time it took to save or load the chunk.
+};
+
+/** Profile of the last saved or loaded game. */
+struct SaveLoadProfile {
+	bool valid = false; ///< Whether this profile is complete.
+	std::string format; ///< Compression format of the savegame.
+	std::vector<SaveLoadChunkProfile> chunks; ///< The chunks, in the order they are in the savegame.
+	size_t size = 0; ///< Number of uncompressed bytes of the savegame.
+	size_t compressed_size = 0; ///< Number of bytes of the savegame file.
+	std::chrono::steady_clock::duration chunks_time{}; ///< Time it took to save or load all chunks; when loading this includes reading and decompressing.
+	std::chrono::steady_clock::duration write_time{}; ///< Time it took to compress and write the savegame; only when saving.
+	std::vector<std::pair<std::string, std::chrono::steady_clock::duration>> afterload; ///< Time taken by the phases of AfterLoadGame; only when loading.
+};
+
+const SaveLoadProfile &GetSaveProfile();
+const SaveLoadProfile &GetLoadProfile();
+
 std::string GenerateDefaultSaveName();
 void SetSaveLoadError(StringID str);
 EncodedString GetSaveLoadErrorType();
@@ -513,6 +541,14 @@ struct ChunkHandler {
 	 */
 	virtual void LoadCheck(size_t len = 0) const;
 
+	/**
+	 * Whether the chunk can be saved concurrently with other chunks.
+	 * Only chunks whose Save() does nothing but read game state, and which
+	 * do not share any temporary state with other chunks, may return true.
+	 * @return True if the chunk can be saved in a worker thread.
+	 */
+	virtual bool CanSaveConcurrently() const { return false; }
+
 	std::string GetName() const
 	{
 		return std::string()
@@ -1392,6 +1428,10 @@ inline void SlSkipBytes(size_t length)
 }
 
 extern std::string _savegame_format;
+extern bool _savegame_block_compression;
+extern bool _savegame_fork_snapshot;
+extern uint8_t _autosave_differential;
+extern uint8_t _savegame_compression_threads;
 extern bool _do_autosave;
 
 /**
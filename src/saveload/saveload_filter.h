@@ -34,6 +34,17 @@ struct LoadFilter {
 	 */
 	virtual size_t Read(uint8_t *buf, size_t len) = 0;
 
+	/**
+	 * Read a given number of bytes from the savegame without copying them.
+	 * Only filters that already have the bytes in memory support this.
+	 * @param len The maximum number of bytes to read.
+	 * @return The read bytes, valid as long as this filter exists; \c std::nullopt when not supported.
+	 */
+	virtual std::optional<std::span<const uint8_t>> ReadSpan([[maybe_unused]] size_t len)
+	{
+		return std::nullopt;
+	}
+
 	/**
 	 * Reset this filter to read from the beginning of the file.
 	 */
@@ -37,6 +37,9 @@ void UpdateHousesAndTowns();
 
 void UpdateOldAircraft();
 
+void ResetAfterLoadProfile();
+void ProfileAfterLoadPhase(std::string_view name);
+
 void SaveViewportBeforeSaveGame();
 void ResetViewportAfterLoadGame();
 
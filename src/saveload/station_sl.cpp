@@ -724,6 +724,8 @@ static const SaveLoad _station_desc[] = {
 struct STNNChunkHandler : ChunkHandler {
 	STNNChunkHandler() : ChunkHandler('STNN', CH_TABLE) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Save() const override
 	{
 		SlTableHeader(_station_desc);
@@ -767,6 +769,8 @@ struct STNNChunkHandler : ChunkHandler {
 struct ROADChunkHandler : ChunkHandler {
 	ROADChunkHandler() : ChunkHandler('ROAD', CH_TABLE) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Save() const override
 	{
 		SlTableHeader(_roadstop_desc);
@@ -1120,6 +1120,8 @@ static const SaveLoad _vehicle_desc[] = {
 struct VEHSChunkHandler : ChunkHandler {
 	VEHSChunkHandler() : ChunkHandler('VEHS', CH_SPARSE_TABLE) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Save() const override
 	{
 		SlTableHeader(_vehicle_desc);
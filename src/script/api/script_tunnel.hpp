@@ -11,6 +11,7 @@
 #define SCRIPT_TUNNEL_HPP
 
 #include "script_vehicle.hpp"
+#include "../../tunnel.h"
 
 /**
  * Class that handles all tunnel related functions.
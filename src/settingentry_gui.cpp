@@ -851,6 +851,7 @@ SettingsContainer &GetSettingsTree()
 			SettingsPage *cdist = environment->Add(new SettingsPage(STR_CONFIG_SETTING_ENVIRONMENT_CARGODIST));
 			{
 				cdist->Add(new SettingEntry("linkgraph.recalc_time"));
+				cdist->Add(new SettingEntry("linkgraph.adaptive_recalc_time"));
 				cdist->Add(new SettingEntry("linkgraph.recalc_interval"));
 				cdist->Add(new SettingEntry("linkgraph.distribution_pax"));
 				cdist->Add(new SettingEntry("linkgraph.distribution_mail"));
@@ -860,6 +861,7 @@ SettingsContainer &GetSettingsTree()
 				cdist->Add(new SettingEntry("linkgraph.demand_distance"));
 				cdist->Add(new SettingEntry("linkgraph.demand_size"));
 				cdist->Add(new SettingEntry("linkgraph.short_path_saturation"));
+				cdist->Add(new SettingEntry("linkgraph.demand_accelerated"));
 			}
 
 			SettingsPage *trees = environment->Add(new SettingsPage(STR_CONFIG_SETTING_ENVIRONMENT_TREES));
@@ -370,6 +370,9 @@ struct NetworkSettings {
 	uint16_t server_port; ///< port the server listens on
 	uint16_t server_admin_port; ///< port the server listens on for the admin network
 	bool server_admin_chat; ///< allow private chat for the server to be distributed to the admin network
+	uint16_t admin_performance_interval; ///< number of ticks between performance updates to the admin network
+	uint16_t admin_vehicle_positions_interval; ///< number of ticks between vehicle position updates to the admin network
+	uint32_t admin_vehicle_positions_bytes; ///< maximum number of bytes of a single vehicle position update to an admin
 	ServerGameType server_game_type; ///< Server type: local / public / invite-only.
 	std::string server_invite_code; ///< Invite code to use when registering as server.
 	std::string server_invite_code_secret; ///< Secret to proof we got this invite code from the Game Coordinator.
@@ -608,6 +611,8 @@ struct LinkGraphSettings {
 	uint8_t demand_size; ///< influence of supply ("station size") on the demand function
 	uint8_t demand_distance; ///< influence of distance between stations on the demand function
 	uint8_t short_path_saturation; ///< percentage up to which short paths are saturated before saturating most capacious paths
+	bool demand_accelerated; ///< only consider nearby stations when calculating demands, trading accuracy for speed on large link graphs
+	bool adaptive_recalc_time; ///< scale the recalculation time of each link graph component by its size
 
 	inline DistributionType GetDistributionType(CargoType cargo) const
 	{
@@ -19,6 +19,7 @@
 #include "vehicle_base.h"
 #include "base_media_func.h"
 #include "base_media_sounds.h"
+#include "network/network.h"
 
 #include "safeguards.h"
 
@@ -98,6 +99,8 @@ void InitializeSound()
 static void StartSound(SoundID sound_id, float pan, uint volume)
 {
 	if (volume == 0) return;
+	/* Nobody would hear the sounds of the ticks that are run back to back. */
+	if (_network_catching_up) return;
 
 	SoundEntry *sound = GetSound(sound_id);
 	if (sound == nullptr) return;
@@ -20,6 +20,8 @@
 #include "spritecache.h"
 #include "spritecache_internal.h"
 
+#include <mutex>
+
 #include "table/sprites.h"
 #include "table/palette_convert.h"
 
@@ -32,6 +34,8 @@ uint _sprite_cache_size = 4;
 static std::vector<SpriteCache> _spritecache;
 static size_t _spritecache_bytes_used = 0;
 static uint32_t _sprite_lru_counter;
+static bool _sprite_cache_shared_reads = false; ///< Whether multiple threads get sprites from the cache. @see SpriteCacheSharedReads
+static std::recursive_mutex _sprite_cache_shared_mutex; ///< Serialises changes to the cache while multiple threads get sprites from it.
 static std::vector<std::unique_ptr<SpriteFile>> _sprite_files;
 
 static inline SpriteCache *GetSpriteCache(uint index)
@@ -703,6 +707,8 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
  */
 static void DeleteEntriesFromSpriteCache(size_t to_remove)
 {
+	assert(!_sprite_cache_shared_reads);
+
 	const size_t initial_in_use = _spritecache_bytes_used;
 
 	struct SpriteInfo {
@@ -844,7 +850,7 @@ static void *HandleInvalidSpriteRequest(SpriteID sprite, SpriteType requested, S
 }
 
 /**
- * Reads a sprite (from disk or sprite cache).
+ * Reads a sprite (from disk or sprite cache), while only one thread uses the sprite cache.
  * If the sprite is not available or of wrong type, a fallback sprite is returned.
  * @param sprite Sprite to read.
  * @param type Expected sprite type.
@@ -852,7 +858,7 @@ static void *HandleInvalidSpriteRequest(SpriteID sprite, SpriteType requested, S
  * @param encoder Sprite encoder to use. Set to nullptr to use the currently active blitter.
  * @return Sprite raw data
  */
-void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator, SpriteEncoder *encoder)
+static void *GetRawSpriteUnshared(SpriteID sprite, SpriteType type, SpriteAllocator *allocator, SpriteEncoder *encoder)
 {
 	assert(type != SpriteType::MapGen || IsMapgenSpriteID(sprite));
 	assert(type < SpriteType::Invalid);
@@ -894,6 +900,49 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 	}
 }
 
+/**
+ * Reads a sprite (from disk or sprite cache).
+ * If the sprite is not available or of wrong type, a fallback sprite is returned.
+ * @param sprite Sprite to read.
+ * @param type Expected sprite type.
+ * @param allocator Allocator function to use. Set to nullptr to use the usual sprite cache.
+ * @param encoder Sprite encoder to use. Set to nullptr to use the currently active blitter.
+ * @return Sprite raw data
+ */
+void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator, SpriteEncoder *encoder)
+{
+	if (_sprite_cache_shared_reads && allocator == nullptr && encoder == nullptr) {
+		/* The sprites are loaded, and their LRU updated, before the threads start; so usually nothing changes. */
+		if (SpriteExists(sprite)) {
+			const SpriteCache *sc = GetSpriteCache(sprite);
+			if (sc->type == type && sc->ptr != nullptr) return static_cast<void *>(sc->ptr.get());
+		}
+
+		/* Anything else changes the cache, so only one thread at a time may do that. */
+		std::lock_guard lock(_sprite_cache_shared_mutex);
+		return GetRawSpriteUnshared(sprite, type, nullptr, nullptr);
+	}
+
+	return GetRawSpriteUnshared(sprite, type, allocator, encoder);
+}
+
+/**
+ * Allow getting sprites from the sprite cache by multiple threads. Sprites
+ * that are not loaded yet, are loaded one thread at a time, but that is slow
+ * and the threads that just read the cache do not wait for it. So load the
+ * sprites before starting the threads.
+ */
+SpriteCacheSharedReads::SpriteCacheSharedReads()
+{
+	assert(!_sprite_cache_shared_reads);
+	_sprite_cache_shared_reads = true;
+}
+
+SpriteCacheSharedReads::~SpriteCacheSharedReads()
+{
+	_sprite_cache_shared_reads = false;
+}
+
 void GfxInitSpriteMem()
 {
 	/* Reset the spritecache 'pool' */
@@ -52,6 +52,15 @@ void GfxClearSpriteCache();
 void GfxClearFontSpriteCache();
 void IncreaseSpriteLRU();
 
+/**
+ * While this exists, multiple threads may get sprites from the sprite cache,
+ * but nothing may remove sprites from it.
+ */
+struct SpriteCacheSharedReads {
+	SpriteCacheSharedReads();
+	~SpriteCacheSharedReads();
+};
+
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 std::span<const std::unique_ptr<SpriteFile>> GetCachedSpriteFiles();
 
@@ -0,0 +1,125 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file linkgraph_refresh.cpp Test the cached link predictions of the link refresher. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../linkgraph/refresh.h"
+#include "../linkgraph/linkgraph.h"
+#include "../linkgraph/linkgraphschedule.h"
+#include "../order_base.h"
+#include "../station_base.h"
+#include "../train.h"
+
+#include "../safeguards.h"
+
+/** Link stats of one edge: source station, destination station, capacity, travel time sum, last unrestricted and restricted update. */
+using LinkStat = std::tuple<StationID, StationID, uint, uint64_t, TimerGameEconomy::Date, TimerGameEconomy::Date>;
+
+/**
+ * Collect the link stats of cargo 0 between all stations, independent of the node IDs in the link graphs.
+ * @return The link stats, sorted.
+ */
+static std::vector<LinkStat> GetLinkStats()
+{
+	std::vector<LinkStat> stats;
+	for (const Station *st : Station::Iterate()) {
+		const GoodsEntry &ge = st->goods[0];
+		const LinkGraph *lg = LinkGraph::GetIfValid(ge.link_graph);
+		if (lg == nullptr) continue;
+		for (const LinkGraph::BaseEdge &edge : (*lg)[ge.node].edges) {
+			stats.emplace_back(st->index, (*lg)[edge.dest_node].station, edge.capacity, edge.travel_time_sum, edge.last_unrestricted_update, edge.last_restricted_update);
+		}
+	}
+	std::ranges::sort(stats);
+	return stats;
+}
+
+/** Remove all link graphs, so the next refresh starts from scratch. */
+static void ResetLinkGraphs()
+{
+	LinkGraphSchedule::Clear();
+	_link_graph_pool.CleanPool();
+	for (Station *st : Station::Iterate()) {
+		for (GoodsEntry &ge : st->goods) {
+			ge.link_graph = LinkGraphID::Invalid();
+			ge.node = INVALID_NODE;
+		}
+	}
+}
+
+/**
+ * Refresh the links of a vehicle from scratch, once with the predictions cached by the previous refresh and once without.
+ * @param v Vehicle to refresh the links of.
+ * @return Link stats after the refresh with and without cached predictions.
+ */
+static std::pair<std::vector<LinkStat>, std::vector<LinkStat>> RefreshWarmAndFresh(Vehicle *v)
+{
+	ResetLinkGraphs();
+	LinkRefresher::Run(v);
+	auto warm = GetLinkStats();
+
+	ResetLinkGraphs();
+	v->orders->InvalidateLinkPredictions();
+	LinkRefresher::Run(v);
+	auto fresh = GetLinkStats();
+
+	return {std::move(warm), std::move(fresh)};
+}
+
+TEST_CASE("LinkRefresher - cached predictions")
+{
+	REQUIRE(Station::CanAllocateItem(4));
+	std::vector<Station *> stations;
+	for (uint i = 0; i < 4; ++i) stations.push_back(Station::Create(TileIndex{16 + 32 * i}));
+
+	REQUIRE(Train::CanAllocateItem());
+	Train *v = Train::Create();
+	v->cargo_type = 0;
+	v->cargo_cap = 30;
+	v->refit_cap = 30;
+	v->vcache.cached_max_speed = 100;
+
+	std::vector<Order> orders(4);
+	orders[0].MakeGoToStation(stations[0]->index);
+	orders[1].MakeGoToStation(stations[1]->index);
+	orders[2].MakeConditional(0);
+	orders[3].MakeGoToStation(stations[2]->index);
+	REQUIRE(OrderList::CanAllocateItem());
+	v->orders = OrderList::Create(std::move(orders), v);
+
+	/* Fill the cache. */
+	LinkRefresher::Run(v);
+
+	auto [warm, fresh] = RefreshWarmAndFresh(v);
+	CHECK(!fresh.empty());
+	CHECK(warm == fresh);
+
+	/* A new order must not use the predictions of the old orders. */
+	Order order;
+	order.MakeGoToStation(stations[3]->index);
+	v->orders->InsertOrderAt(std::move(order), 1);
+
+	LinkRefresher::Run(v);
+	auto [changed_warm, changed_fresh] = RefreshWarmAndFresh(v);
+	CHECK(changed_fresh != fresh);
+	CHECK(changed_warm == changed_fresh);
+
+	/* A different start order gets its own prediction. */
+	v->cur_implicit_order_index = 3;
+	LinkRefresher::Run(v);
+	auto [other_warm, other_fresh] = RefreshWarmAndFresh(v);
+	CHECK(other_warm == other_fresh);
+
+	ResetLinkGraphs();
+	_vehicle_pool.CleanPool();
+	_orderlist_pool.CleanPool();
+	_station_pool.CleanPool();
+}
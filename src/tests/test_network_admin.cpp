@@ -0,0 +1,232 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file test_network_admin.cpp Tests for the vehicle position feed of the admin port. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../network/network_admin.h"
+#include "../network/core/packet.h"
+
+#include "../safeguards.h"
+
+static NetworkSocketHandler admin_socket_handler;
+
+/** A vehicle record of a \c PacketAdminType::ServerVehiclePositions packet, as an admin decodes it. */
+struct VehicleRecord {
+	uint32_t id = 0;
+	AdminVehicleChanges changes{};
+	uint8_t type = 0;
+	uint8_t owner = 0;
+	int32_t x = 0;
+	int32_t y = 0;
+	uint8_t state = 0;
+};
+
+/**
+ * Decode the packets of an update like an admin would.
+ * @param packets The packets written by the server.
+ * @param frame The frame counter the packets must have.
+ * @return The vehicle records of all packets.
+ */
+static std::vector<VehicleRecord> DecodeVehiclePositions(std::vector<std::unique_ptr<Packet>> &packets, uint32_t frame)
+{
+	std::vector<VehicleRecord> records;
+	for (auto &source : packets) {
+		source->PrepareToSend();
+
+		Packet p(&admin_socket_handler, COMPAT_MTU, source->Size());
+		p.TransferIn([&source](std::span<uint8_t> dest_data) {
+			return source->TransferOutWithLimit([&dest_data](std::span<const uint8_t> source_data) {
+				std::ranges::copy(source_data, dest_data.begin());
+				return source_data.size();
+			}, dest_data.size());
+		});
+		REQUIRE(p.PrepareToRead());
+		CHECK(p.Recv_uint8() == to_underlying(PacketAdminType::ServerVehiclePositions));
+		CHECK(p.Recv_uint32() == frame);
+
+		while (p.CanReadFromPacket(sizeof(uint32_t) + sizeof(uint8_t))) {
+			VehicleRecord &record = records.emplace_back();
+			record.id = p.Recv_uint32();
+			record.changes = AdminVehicleChanges{p.Recv_uint8()};
+			if (record.changes.Test(AdminVehicleChange::New)) {
+				record.type = p.Recv_uint8();
+				record.owner = p.Recv_uint8();
+			}
+			if (record.changes.Test(AdminVehicleChange::Position)) {
+				record.x = static_cast<int32_t>(p.Recv_uint32());
+				record.y = static_cast<int32_t>(p.Recv_uint32());
+			}
+			if (record.changes.Test(AdminVehicleChange::State)) record.state = p.Recv_uint8();
+		}
+		CHECK(p.RemainingBytesToTransfer() == 0);
+	}
+	return records;
+}
+
+/**
+ * Create a vehicle as the server would describe it to an admin.
+ * Like constructing a vehicle, every call gives a new generation.
+ * @param x The X coordinate.
+ * @param y The Y coordinate.
+ * @param owner The owner.
+ * @return The vehicle.
+ */
+static AdminVehicleInfo MakeVehicle(int32_t x, int32_t y, Owner owner)
+{
+	static uint64_t generation = 0;
+
+	AdminVehicleInfo info{};
+	info.x = x;
+	info.y = y;
+	info.type = VEH_TRAIN;
+	info.owner = owner;
+	info.generation = ++generation;
+	return info;
+}
+
+static constexpr size_t NEW_RECORD_SIZE = 4 + 1 + 2 + 8 + 1; ///< Size of a record of a new vehicle.
+static constexpr size_t POSITION_RECORD_SIZE = 4 + 1 + 8; ///< Size of a record with only a changed position.
+
+TEST_CASE("Admin vehicle positions - new, position, state and removed")
+{
+	AdminVehiclePositionFeed feed;
+
+	std::vector<AdminVehicleInfo> vehicles(3);
+	vehicles[0] = MakeVehicle(16, 32, CompanyID::Begin());
+	vehicles[2] = MakeVehicle(-5, 48, OWNER_NONE);
+
+	auto packets = feed.WriteChanges(&admin_socket_handler, vehicles, 10, SIZE_MAX);
+	auto records = DecodeVehiclePositions(packets, 10);
+	REQUIRE(records.size() == 2);
+	CHECK(records[0].id == 0);
+	CHECK(records[0].changes == AdminVehicleChanges{AdminVehicleChange::New, AdminVehicleChange::Position, AdminVehicleChange::State});
+	CHECK(records[0].type == VEH_TRAIN);
+	CHECK(records[0].owner == CompanyID::Begin().base());
+	CHECK(records[0].x == 16);
+	CHECK(records[0].y == 32);
+	CHECK(records[0].state == to_underlying(AdminVehicleState::Running));
+	CHECK(records[1].id == 2);
+	CHECK(records[1].owner == OWNER_NONE.base());
+	CHECK(records[1].x == -5);
+
+	/* Nothing changed, so nothing is sent. */
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 11, SIZE_MAX);
+	CHECK(packets.empty());
+
+	/* Only the changed fields are sent. */
+	vehicles[0].x = 17;
+	vehicles[2].state = AdminVehicleState::Loading;
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 12, SIZE_MAX);
+	records = DecodeVehiclePositions(packets, 12);
+	REQUIRE(records.size() == 2);
+	CHECK(records[0].id == 0);
+	CHECK(records[0].changes == AdminVehicleChanges{AdminVehicleChange::Position});
+	CHECK(records[0].x == 17);
+	CHECK(records[0].y == 32);
+	CHECK(records[1].id == 2);
+	CHECK(records[1].changes == AdminVehicleChanges{AdminVehicleChange::State});
+	CHECK(records[1].state == to_underlying(AdminVehicleState::Loading));
+
+	/* A vehicle that is gone is sent once as removed, also when the pool shrunk. */
+	vehicles.resize(1);
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 13, SIZE_MAX);
+	records = DecodeVehiclePositions(packets, 13);
+	REQUIRE(records.size() == 1);
+	CHECK(records[0].id == 2);
+	CHECK(records[0].changes == AdminVehicleChanges{AdminVehicleChange::Removed});
+
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 14, SIZE_MAX);
+	CHECK(packets.empty());
+}
+
+TEST_CASE("Admin vehicle positions - reused vehicle ID")
+{
+	AdminVehiclePositionFeed feed;
+
+	std::vector<AdminVehicleInfo> vehicles(1);
+	vehicles[0] = MakeVehicle(16, 32, CompanyID::Begin());
+	feed.WriteChanges(&admin_socket_handler, vehicles, 1, SIZE_MAX);
+
+	/* Between two updates the vehicle got sold, and a vehicle with the same position, type and owner got the same ID. */
+	vehicles[0] = MakeVehicle(16, 32, CompanyID::Begin());
+	auto packets = feed.WriteChanges(&admin_socket_handler, vehicles, 2, SIZE_MAX);
+	auto records = DecodeVehiclePositions(packets, 2);
+	REQUIRE(records.size() == 1);
+	CHECK(records[0].changes == AdminVehicleChanges{AdminVehicleChange::Removed, AdminVehicleChange::New, AdminVehicleChange::Position, AdminVehicleChange::State});
+	CHECK(records[0].type == VEH_TRAIN);
+	CHECK(records[0].owner == CompanyID::Begin().base());
+	CHECK(records[0].x == 16);
+
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 3, SIZE_MAX);
+	CHECK(packets.empty());
+
+	/* The same vehicle that changed owner is not removed, but its new owner is sent. */
+	vehicles[0].owner = CompanyID{1};
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 4, SIZE_MAX);
+	records = DecodeVehiclePositions(packets, 4);
+	REQUIRE(records.size() == 1);
+	CHECK(records[0].changes == AdminVehicleChanges{AdminVehicleChange::New});
+	CHECK(records[0].owner == 1);
+}
+
+TEST_CASE("Admin vehicle positions - continue at the cursor when the byte cap is hit")
+{
+	AdminVehiclePositionFeed feed;
+
+	std::vector<AdminVehicleInfo> vehicles;
+	for (int32_t i = 0; i < 5; i++) vehicles.push_back(MakeVehicle(i * 16, 0, CompanyID::Begin()));
+
+	/* Only two new vehicles fit. */
+	auto packets = feed.WriteChanges(&admin_socket_handler, vehicles, 1, 2 * NEW_RECORD_SIZE + 1);
+	auto records = DecodeVehiclePositions(packets, 1);
+	REQUIRE(records.size() == 2);
+	CHECK(records[0].id == 0);
+	CHECK(records[1].id == 1);
+
+	/* Vehicle 0 moves, but the next update continues with the vehicles that were skipped. */
+	vehicles[0].x = 1;
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 2, 2 * NEW_RECORD_SIZE);
+	records = DecodeVehiclePositions(packets, 2);
+	REQUIRE(records.size() == 2);
+	CHECK(records[0].id == 2);
+	CHECK(records[1].id == 3);
+
+	/* After the last skipped vehicle, it wraps around to vehicle 0. */
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 3, NEW_RECORD_SIZE + POSITION_RECORD_SIZE);
+	records = DecodeVehiclePositions(packets, 3);
+	REQUIRE(records.size() == 2);
+	CHECK(records[0].id == 4);
+	CHECK(records[0].changes.Test(AdminVehicleChange::New));
+	CHECK(records[1].id == 0);
+	CHECK(records[1].changes == AdminVehicleChanges{AdminVehicleChange::Position});
+	CHECK(records[1].x == 1);
+
+	packets = feed.WriteChanges(&admin_socket_handler, vehicles, 4, SIZE_MAX);
+	CHECK(packets.empty());
+}
+
+TEST_CASE("Admin vehicle positions - split over several packets")
+{
+	AdminVehiclePositionFeed feed;
+
+	std::vector<AdminVehicleInfo> vehicles;
+	for (int32_t i = 0; i < 200; i++) vehicles.push_back(MakeVehicle(i, i, CompanyID::Begin()));
+
+	auto packets = feed.WriteChanges(&admin_socket_handler, vehicles, 7, SIZE_MAX);
+	CHECK(packets.size() > 1);
+
+	auto records = DecodeVehiclePositions(packets, 7);
+	REQUIRE(records.size() == vehicles.size());
+	for (uint32_t i = 0; i < records.size(); i++) {
+		CHECK(records[i].id == i);
+		CHECK(records[i].x == static_cast<int32_t>(i));
+	}
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file viewport_sprite_sorter.cpp Test that the sprite sorters sort into the same order. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../viewport_sprite_sorter.h"
+
+#include <random>
+
+#include "../safeguards.h"
+
+/**
+ * Sort the sprites with a sorter.
+ * @param sprites The sprites to sort; they are not changed apart from their order member.
+ * @param sorter The sorter to use.
+ * @return The indices of the sprites in the sorted order.
+ */
+static std::vector<size_t> SortSprites(std::vector<ParentSpriteToDraw> &sprites, VpSpriteSorter sorter)
+{
+	ParentSpriteToSortVector psdv;
+	for (ParentSpriteToDraw &ps : sprites) psdv.push_back(&ps);
+
+	sorter(&psdv);
+
+	std::vector<size_t> order;
+	for (const ParentSpriteToDraw *ps : psdv) order.push_back(ps - sprites.data());
+	return order;
+}
+
+/**
+ * Make a sprite with the given bounding box.
+ * @return The sprite.
+ */
+static ParentSpriteToDraw MakeSprite(int32_t xmin, int32_t ymin, int32_t zmin, int32_t xmax, int32_t ymax, int32_t zmax)
+{
+	ParentSpriteToDraw ps{};
+	ps.xmin = xmin;
+	ps.ymin = ymin;
+	ps.zmin = zmin;
+	ps.xmax = xmax;
+	ps.ymax = ymax;
+	ps.zmax = zmax;
+	return ps;
+}
+
+/**
+ * Check that the bucket sorter sorts the sprites into the same order as the original sorter.
+ * @param sprites The sprites to sort.
+ */
+static void CheckSameOrder(std::vector<ParentSpriteToDraw> &sprites)
+{
+	std::vector<size_t> expected = SortSprites(sprites, &ViewportSortParentSprites);
+	std::vector<size_t> buckets = SortSprites(sprites, &ViewportSortParentSpritesBuckets);
+	CHECK(buckets == expected);
+}
+
+TEST_CASE("ViewportSortParentSpritesBuckets - random boxes")
+{
+	std::mt19937 random(2024);
+
+	for (size_t count : {0, 1, 2, 3, 17, 100, 1000}) {
+		std::vector<ParentSpriteToDraw> sprites;
+		for (size_t i = 0; i < count; i++) {
+			int32_t x = random() % 512, y = random() % 512, z = random() % 128;
+			/* Mostly proper boxes, but sometimes with a minimum beyond the maximum, like some real sprites. */
+			int32_t dx = static_cast<int32_t>(random() % 40) - 4, dy = static_cast<int32_t>(random() % 40) - 4, dz = static_cast<int32_t>(random() % 40) - 4;
+			sprites.push_back(MakeSprite(x, y, z, x + dx, y + dy, z + dz));
+		}
+		CheckSameOrder(sprites);
+	}
+}
+
+TEST_CASE("ViewportSortParentSpritesBuckets - grid boxes")
+{
+	std::mt19937 random(42);
+
+	for (int32_t size : {1, 4, 16, 40}) {
+		std::vector<ParentSpriteToDraw> sprites;
+		for (int32_t tx = 0; tx < size; tx++) {
+			for (int32_t ty = 0; ty < size; ty++) {
+				int32_t x = tx * 16, y = ty * 16, z = (random() % 4) * 8;
+				/* A tile-sized foundation or building, and sometimes a vehicle on top of it. */
+				sprites.push_back(MakeSprite(x, y, z, x + 15, y + 15, z + static_cast<int32_t>(random() % 64)));
+				if (random() % 4 == 0) {
+					int32_t vx = x + static_cast<int32_t>(random() % 12), vy = y + static_cast<int32_t>(random() % 12);
+					sprites.push_back(MakeSprite(vx, vy, z + 8, vx + 3, vy + 3, z + 14));
+				}
+			}
+		}
+		std::shuffle(sprites.begin(), sprites.end(), random);
+		CheckSameOrder(sprites);
+	}
+}
@@ -110,6 +110,7 @@ public:
 		/* All other may have a Random() call in them, so order is important.
 		 * For safety, you can only setup a single timer on a single priority. */
 
+		CargoPacket, ///< Compacting cargo packets.
 		Company, ///< Changes to companies.
 		Disaster, ///< Running disaster logic.
 		Engine, ///< Running engine availability updates.
@@ -48,7 +48,7 @@ static inline const TunnelSpec *GetTunnelSpec(TunnelType i)
 	return &_tunnel[i];
 }
 
-CommandCost CheckTunnelAvailability(TunnelType tunnel_type, uint tunnel_len, DoCommandFlag flags = {});
+CommandCost CheckTunnelAvailability(TunnelType tunnel_type, uint tunnel_len, DoCommandFlags flags = {});
 int CalcTunnelLenCostFactor(int x);
 
 void ResetTunnels();
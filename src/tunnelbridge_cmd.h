@@ -18,8 +18,8 @@
 #include "bridge.h"
 #include "tunnel.h"
 
-CommandCost CmdBuildBridge(DoCommandFlag flags, TileIndex tile_end, TileIndex tile_start, TransportType transport_type, BridgeType bridge_type, RailType railtype, RoadType roadtype);
-CommandCost CmdBuildTunnel(DoCommandFlag flags, TileIndex tile_start, TransportType transport_type, TunnelType tunnel_type, RailType railtype, RoadType roadtype);
+CommandCost CmdBuildBridge(DoCommandFlags flags, TileIndex tile_end, TileIndex tile_start, TransportType transport_type, BridgeType bridge_type, RailType railtype, RoadType roadtype);
+CommandCost CmdBuildTunnel(DoCommandFlags flags, TileIndex tile_start, TransportType transport_type, TunnelType tunnel_type, RailType railtype, RoadType roadtype);
 
 DEF_CMD_TRAIT(Commands::BuildBridge, CmdBuildBridge, CommandFlags({CommandFlag::Deity, CommandFlag::Auto, CommandFlag::NoWater}), CommandType::LandscapeConstruction)
 DEF_CMD_TRAIT(Commands::BuildTunnel, CmdBuildTunnel, CommandFlags({CommandFlag::Deity, CommandFlag::Auto}),                       CommandType::LandscapeConstruction)
@@ -371,6 +371,8 @@ void VehicleLengthChanged(const Vehicle *u)
 	}
 }
 
+static uint64_t _vehicle_generation = 0; ///< Number of vehicles constructed so far, see Vehicle::generation.
+
 /**
  * Vehicle constructor.
  * @param index The index within the vehicle pool.
@@ -378,6 +380,7 @@ void VehicleLengthChanged(const Vehicle *u)
  */
 Vehicle::Vehicle(VehicleID index, VehicleType type) : VehiclePool::PoolItem<&_vehicle_pool>(index)
 {
+	this->generation         = ++_vehicle_generation;
 	this->type               = type;
 	this->coord.left         = INVALID_COORD;
 	this->sprite_cache.old_coord.left = INVALID_COORD;
@@ -248,6 +248,7 @@ public:
 	Vehicle **hash_tile_current = nullptr; ///< NOSAVE: Cache of the current hash chain.
 
 	SpriteID colourmap{}; ///< NOSAVE: cached colour mapping
+	uint64_t generation = 0; ///< NOSAVE: Sequence number of the construction of this vehicle, to tell vehicles apart that got the same index.
 
 	/* Related to age and service time */
 	TimerGameCalendar::Year build_year{}; ///< Year the vehicle has been built.
@@ -219,6 +219,11 @@ void VideoDriver_Dedicated::MainLoop()
 		this->DrainCommandQueue();
 
 		this->Tick();
-		this->SleepTillNextTick();
+
+		/* Handle network traffic as it arrives while waiting for the next tick. */
+		auto next_tick = this->GetNextTick();
+		for (auto now = std::chrono::steady_clock::now(); now < next_tick && !_exit_game; now = std::chrono::steady_clock::now()) {
+			NetworkServerWaitForIO(next_tick - now);
+		}
 	}
 }
@@ -170,15 +170,26 @@ void VideoDriver::Tick()
 	}
 }
 
-void VideoDriver::SleepTillNextTick()
+/**
+ * Get when the next tick is about to happen.
+ * @return The time of the next game or draw tick.
+ */
+std::chrono::steady_clock::time_point VideoDriver::GetNextTick() const
 {
 	auto next_tick = this->next_draw_tick;
-	auto now = std::chrono::steady_clock::now();
 
 	if (!this->is_game_threaded) {
 		next_tick = min(next_tick, this->next_game_tick);
 	}
 
+	return next_tick;
+}
+
+void VideoDriver::SleepTillNextTick()
+{
+	auto next_tick = this->GetNextTick();
+	auto now = std::chrono::steady_clock::now();
+
 	if (next_tick > now) {
 		std::this_thread::sleep_for(next_tick - now);
 	}
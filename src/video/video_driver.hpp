@@ -310,6 +310,8 @@ protected:
 	 */
 	void SleepTillNextTick();
 
+	std::chrono::steady_clock::time_point GetNextTick() const;
+
 	std::chrono::steady_clock::duration GetGameInterval()
 	{
 #ifdef DEBUG_DUMP_COMMANDS
@@ -90,7 +90,16 @@
 #include "network/network_func.h"
 #include "framerate_type.h"
 #include "viewport_cmd.h"
-
+#include "spritecache.h"
+#include "newgrf_debug.h"
+#include "thread.h"
+#include "console_func.h"
+#include "fileio_func.h"
+#include "core/string_consumer.hpp"
+#include "3rdparty/fmt/chrono.h"
+
+#include <chrono>
+#include <condition_variable>
 #include <forward_list>
 #include <stack>
 
@@ -196,6 +205,8 @@ bool _draw_bounding_boxes = false;
 bool _draw_dirty_blocks = false;
 uint _dirty_block_colour = 0;
 static VpSpriteSorter _vp_sprite_sorter = nullptr;
+static bool _sprite_sorting_capture = false; ///< Whether the sprites that get sorted are captured. @see CaptureSpriteSorting
+static std::vector<std::vector<ParentSpriteToDraw>> _sprite_sorting_captured; ///< The captured sprites of each sort.
 
 static Point MapXYZToViewport(const Viewport &vp, int x, int y, int z)
 {
@@ -1592,7 +1603,7 @@ static void ViewportDrawTileSprites(const TileSpriteToDrawVector *tstdv)
  * Sort parent sprites pointer array replicating the way original sorter did it.
  * @param psdv The sprites to sort.
  */
-static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
+void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 {
 	if (psdv->size() < 2) return;
 
@@ -1712,6 +1723,170 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 }
 
 
+/**
+ * Sort parent sprites pointer array into the same order as #ViewportSortParentSprites, but find
+ * the sprites that have to be drawn before a sprite without walking over all sprites on its diagonal.
+ *
+ * A sprite p can only precede sprite s when p->xmin <= s->xmax and p->ymin <= s->ymax. The sprites
+ * are put in buckets by xmin + ymin, and sorted by xmin within a bucket. So only the buckets up to
+ * s->xmax + s->ymax have to be searched, and in a bucket with sums from lo only the sprites with
+ * xmin between lo - s->ymax and s->xmax. On a busy screen most sprites with about the same sum
+ * are elsewhere on the diagonal, and those are skipped.
+ * @param psdv The sprites to sort.
+ */
+void ViewportSortParentSpritesBuckets(ParentSpriteToSortVector *psdv)
+{
+	if (psdv->size() < 2) return;
+
+	/* See ViewportSortParentSprites for how these work. */
+	const uint32_t ORDER_COMPARED = UINT32_MAX;
+	const uint32_t ORDER_RETURNED = UINT32_MAX - 1;
+	std::stack<ParentSpriteToDraw *> sprite_order;
+	uint32_t next_order = 0;
+
+	int64_t min_sum = INT64_MAX;
+	int64_t max_sum = INT64_MIN;
+	for (auto p = psdv->rbegin(); p != psdv->rend(); p++) {
+		sprite_order.push(*p);
+		(*p)->order = next_order++;
+
+		int64_t sum = static_cast<int64_t>((*p)->xmin) + (*p)->ymin;
+		min_sum = std::min(min_sum, sum);
+		max_sum = std::max(max_sum, sum);
+	}
+
+	/* Aim for about 16 sprites per bucket; with smaller buckets more time is spent on skipping empty buckets. */
+	uint shift = 0;
+	while (((max_sum - min_sum) >> shift) > static_cast<int64_t>(psdv->size() / 16)) shift++;
+	size_t num_buckets = static_cast<size_t>((max_sum - min_sum) >> shift) + 1;
+	auto bucket_of = [min_sum, shift](const ParentSpriteToDraw *p) -> size_t {
+		return static_cast<size_t>((static_cast<int64_t>(p->xmin) + p->ymin - min_sum) >> shift);
+	};
+
+	/** A sprite in a bucket. */
+	struct BucketEntry {
+		int32_t xmin; ///< Minimal X coordinate of the sprite.
+		ParentSpriteToDraw *sprite; ///< The sprite, or \c nullptr when it is removed.
+	};
+	std::vector<BucketEntry> entries(psdv->size());
+	std::vector<size_t> bucket_begin(num_buckets + 1); ///< First entry of each bucket.
+	std::vector<size_t> bucket_end(num_buckets); ///< End of the entries of each bucket; less than the next begin after removed entries got compacted.
+	std::vector<size_t> bucket_live(num_buckets); ///< Number of entries in each bucket that are not removed.
+
+	for (const ParentSpriteToDraw *p : *psdv) bucket_live[bucket_of(p)]++;
+	for (size_t b = 0; b < num_buckets; b++) {
+		bucket_begin[b + 1] = bucket_begin[b] + bucket_live[b];
+		bucket_end[b] = bucket_begin[b];
+	}
+	for (ParentSpriteToDraw *p : *psdv) entries[bucket_end[bucket_of(p)]++] = {p->xmin, p};
+
+	auto by_xmin = [](const BucketEntry &entry, int64_t xmin) { return entry.xmin < xmin; };
+	for (size_t b = 0; b < num_buckets; b++) {
+		std::sort(entries.begin() + bucket_begin[b], entries.begin() + bucket_end[b], [](const BucketEntry &x, const BucketEntry &y) { return x.xmin < y.xmin; });
+	}
+
+	/* All buckets before this one are empty. */
+	size_t first_bucket = 0;
+
+	auto remove = [&](ParentSpriteToDraw *p) {
+		size_t b = bucket_of(p);
+		auto first = entries.begin() + bucket_begin[b];
+		auto last = entries.begin() + bucket_end[b];
+		auto it = std::lower_bound(first, last, p->xmin, by_xmin);
+		while (it->sprite != p) ++it;
+		it->sprite = nullptr;
+
+		/* Do not let removed entries pile up, as the searches would walk over them. */
+		if (--bucket_live[b] * 2 < static_cast<size_t>(last - first)) {
+			bucket_end[b] = std::remove_if(first, last, [](const BucketEntry &entry) { return entry.sprite == nullptr; }) - entries.begin();
+		}
+		while (first_bucket < num_buckets && bucket_live[first_bucket] == 0) first_bucket++;
+	};
+
+	std::vector<ParentSpriteToDraw *> preceding;
+	auto out = psdv->begin();
+
+	while (!sprite_order.empty()) {
+
+		auto s = sprite_order.top();
+		sprite_order.pop();
+
+		/* Sprite is already sorted, ignore it. */
+		if (s->order == ORDER_RETURNED) continue;
+
+		/* Sprite was already compared, just need to output it. */
+		if (s->order == ORDER_COMPARED) {
+			*(out++) = s;
+			s->order = ORDER_RETURNED;
+			continue;
+		}
+
+		remove(s);
+		preceding.clear();
+
+		int64_t max_sum_preceding = static_cast<int64_t>(s->xmax) + s->ymax;
+		if (max_sum_preceding >= min_sum) {
+			size_t last_bucket = std::min(num_buckets - 1, static_cast<size_t>((max_sum_preceding - min_sum) >> shift));
+			for (size_t b = first_bucket; b <= last_bucket; b++) {
+				if (bucket_live[b] == 0) continue;
+
+				int64_t lowest_sum = min_sum + (static_cast<int64_t>(b) << shift);
+				auto last = entries.begin() + bucket_end[b];
+				for (auto it = std::lower_bound(entries.begin() + bucket_begin[b], last, lowest_sum - s->ymax, by_xmin); it != last && it->xmin <= s->xmax; ++it) {
+					auto p = it->sprite;
+					if (p == nullptr) continue;
+
+					/* The same checks as ViewportSortParentSprites, so the result is the same. */
+					if (s->xmax < p->xmin || s->ymax < p->ymin || s->zmax < p->zmin) continue;
+					if (s->xmin <= p->xmax && // overlap in X?
+							s->ymin <= p->ymax && // overlap in Y?
+							s->zmin <= p->zmax) { // overlap in Z?
+						if (s->xmin + s->xmax + s->ymin + s->ymax + s->zmin + s->zmax <=
+								p->xmin + p->xmax + p->ymin + p->ymax + p->zmin + p->zmax) {
+							continue;
+						}
+					}
+					preceding.push_back(p);
+				}
+			}
+		}
+
+		if (preceding.empty()) {
+			/* No preceding sprites, add current one to the output */
+			*(out++) = s;
+			s->order = ORDER_RETURNED;
+			continue;
+		}
+
+		/* Optimization for the case when we only have 1 sprite to move. */
+		if (preceding.size() == 1) {
+			auto p = preceding[0];
+			/* We can only output the preceding sprite if there can't be any other sprites preceding it. */
+			if (p->xmax <= s->xmax && p->ymax <= s->ymax && p->zmax <= s->zmax) {
+				p->order = ORDER_RETURNED;
+				s->order = ORDER_RETURNED;
+				remove(p);
+				*(out++) = p;
+				*(out++) = s;
+				continue;
+			}
+		}
+
+		/* Sort all preceding sprites by order and assign new orders in reverse (as original sorter did). */
+		std::sort(preceding.begin(), preceding.end(), [](const ParentSpriteToDraw *a, const ParentSpriteToDraw *b) {
+			return a->order > b->order;
+		});
+
+		s->order = ORDER_COMPARED;
+		sprite_order.push(s);  // Still need to output so push it back for now
+
+		for (auto p: preceding) {
+			p->order = next_order++;
+			sprite_order.push(p);
+		}
+	}
+}
+
 static void ViewportDrawParentSprites(const ParentSpriteToSortVector *psd, const ChildScreenSpriteToDrawVector *csstdv)
 {
 	for (const ParentSpriteToDraw *ps : *psd) {
@@ -1807,24 +1982,50 @@ static void ViewportDrawStrings(ZoomLevel zoom, const StringSpriteToDrawVector *
 	}
 }
 
-void ViewportDoDraw(const Viewport &vp, int left, int top, int right, int bottom)
+/**
+ * Get the drawing area of a part of a viewport in the current drawing area.
+ * @param vp The viewport.
+ * @param left Left edge of the part, in viewport coordinates.
+ * @param top Top edge of the part, in viewport coordinates.
+ * @param width Width of the part, in viewport coordinates.
+ * @param height Height of the part, in viewport coordinates.
+ * @pre All coordinates are aligned to the zoom level of the viewport.
+ * @return The drawing area, in viewport coordinates.
+ */
+static DrawPixelInfo GetViewportDrawArea(const Viewport &vp, int left, int top, int width, int height)
 {
-	_vd.dpi.zoom = vp.zoom;
+	DrawPixelInfo dpi{};
+	dpi.zoom = vp.zoom;
 	int mask = ScaleByZoom(-1, vp.zoom);
 
-	_vd.combine_sprites = SPRITE_COMBINE_NONE;
+	dpi.width = width;
+	dpi.height = height;
+	dpi.left = left;
+	dpi.top = top;
+	dpi.pitch = _cur_dpi->pitch;
 
-	_vd.dpi.width = (right - left) & mask;
-	_vd.dpi.height = (bottom - top) & mask;
-	_vd.dpi.left = left & mask;
-	_vd.dpi.top = top & mask;
-	_vd.dpi.pitch = _cur_dpi->pitch;
-	_vd.last_child = LAST_CHILD_NONE;
+	int x = UnScaleByZoom(dpi.left - (vp.virtual_left & mask), vp.zoom) + vp.left;
+	int y = UnScaleByZoom(dpi.top - (vp.virtual_top & mask), vp.zoom) + vp.top;
 
-	int x = UnScaleByZoom(_vd.dpi.left - (vp.virtual_left & mask), vp.zoom) + vp.left;
-	int y = UnScaleByZoom(_vd.dpi.top - (vp.virtual_top & mask), vp.zoom) + vp.top;
+	dpi.dst_ptr = BlitterFactory::GetCurrentBlitter()->MoveTo(_cur_dpi->dst_ptr, x - _cur_dpi->left, y - _cur_dpi->top);
+	return dpi;
+}
+
+/**
+ * Collect the sprites of a part of a viewport into #_vd.
+ * @param vp The viewport.
+ * @param left Left edge of the part, in viewport coordinates.
+ * @param top Top edge of the part, in viewport coordinates.
+ * @param width Width of the part, in viewport coordinates.
+ * @param height Height of the part, in viewport coordinates.
+ * @pre All coordinates are aligned to the zoom level of the viewport.
+ */
+static void ViewportCollectSprites(const Viewport &vp, int left, int top, int width, int height)
+{
+	_vd.dpi = GetViewportDrawArea(vp, left, top, width, height);
+	_vd.combine_sprites = SPRITE_COMBINE_NONE;
+	_vd.last_child = LAST_CHILD_NONE;
 
-	_vd.dpi.dst_ptr = BlitterFactory::GetCurrentBlitter()->MoveTo(_cur_dpi->dst_ptr, x - _cur_dpi->left, y - _cur_dpi->top);
 	AutoRestoreBackup dpi_backup(_cur_dpi, &_vd.dpi);
 
 	ViewportAddLandscape();
@@ -1834,44 +2035,235 @@ void ViewportDoDraw(const Viewport &vp, int left, int top, int right, int bottom
 
 	DrawTextEffects(&_vd.dpi);
 
-	if (!_vd.tile_sprites_to_draw.empty()) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
-
 	for (auto &psd : _vd.parent_sprites_to_draw) {
 		_vd.parent_sprites_to_sort.push_back(&psd);
 	}
 
-	_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
-	ViewportDrawParentSprites(&_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw);
+	if (_sprite_sorting_capture && _vd.parent_sprites_to_sort.size() >= 2) {
+		auto &sort = _sprite_sorting_captured.emplace_back();
+		for (const ParentSpriteToDraw *ps : _vd.parent_sprites_to_sort) sort.push_back(*ps);
+	}
+}
 
-	if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&_vd.parent_sprites_to_sort);
+/**
+ * Sort and draw the collected sprites of a part of a viewport.
+ * This only reads the sprite cache, so multiple threads may do this at the same time for different parts.
+ * @param vd The collected sprites.
+ */
+static void ViewportDrawSprites(ViewportDrawer &vd)
+{
+	AutoRestoreBackup dpi_backup(_cur_dpi, &vd.dpi);
+
+	if (!vd.tile_sprites_to_draw.empty()) ViewportDrawTileSprites(&vd.tile_sprites_to_draw);
+
+	_vp_sprite_sorter(&vd.parent_sprites_to_sort);
+	ViewportDrawParentSprites(&vd.parent_sprites_to_sort, &vd.child_screen_sprites_to_draw);
+
+	if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&vd.parent_sprites_to_sort);
 	if (_draw_dirty_blocks) ViewportDrawDirtyBlocks();
+}
+
+/**
+ * Draw the link graph overlay of a part of a viewport.
+ * @param vp The viewport.
+ * @param area The drawing area of the part, see #GetViewportDrawArea.
+ */
+static void ViewportDrawOverlay(const Viewport &vp, const DrawPixelInfo &area)
+{
+	if (vp.overlay == nullptr || vp.overlay->GetCargoMask() == 0 || vp.overlay->GetCompanyMask().None()) return;
 
-	DrawPixelInfo dp = _vd.dpi;
-	ZoomLevel zoom = _vd.dpi.zoom;
+	DrawPixelInfo dp = area;
+	ZoomLevel zoom = area.zoom;
 	dp.zoom = ZoomLevel::Min;
 	dp.width = UnScaleByZoom(dp.width, zoom);
 	dp.height = UnScaleByZoom(dp.height, zoom);
 	AutoRestoreBackup cur_dpi(_cur_dpi, &dp);
 
-	if (vp.overlay != nullptr && vp.overlay->GetCargoMask() != 0 && vp.overlay->GetCompanyMask().Any()) {
-		/* translate to window coordinates */
-		dp.left = x;
-		dp.top = y;
-		vp.overlay->Draw(&dp);
-	}
+	/* translate to window coordinates */
+	int mask = ScaleByZoom(-1, zoom);
+	dp.left = UnScaleByZoom(area.left - (vp.virtual_left & mask), zoom) + vp.left;
+	dp.top = UnScaleByZoom(area.top - (vp.virtual_top & mask), zoom) + vp.top;
+	vp.overlay->Draw(&dp);
+}
+
+/**
+ * Draw the strings of a part of a viewport, and forget its collected sprites.
+ * @param vd The collected sprites.
+ */
+static void ViewportDrawCollectedStrings(ViewportDrawer &vd)
+{
+	if (!vd.string_sprites_to_draw.empty()) {
+		DrawPixelInfo dp = vd.dpi;
+		ZoomLevel zoom = vd.dpi.zoom;
+		dp.zoom = ZoomLevel::Min;
+		dp.width = UnScaleByZoom(dp.width, zoom);
+		dp.height = UnScaleByZoom(dp.height, zoom);
+		AutoRestoreBackup cur_dpi(_cur_dpi, &dp);
 
-	if (!_vd.string_sprites_to_draw.empty()) {
 		/* translate to world coordinates */
-		dp.left = UnScaleByZoom(_vd.dpi.left, zoom);
-		dp.top = UnScaleByZoom(_vd.dpi.top, zoom);
-		ViewportDrawStrings(zoom, &_vd.string_sprites_to_draw);
+		dp.left = UnScaleByZoom(vd.dpi.left, zoom);
+		dp.top = UnScaleByZoom(vd.dpi.top, zoom);
+		ViewportDrawStrings(zoom, &vd.string_sprites_to_draw);
+	}
+
+	vd.string_sprites_to_draw.clear();
+	vd.tile_sprites_to_draw.clear();
+	vd.parent_sprites_to_draw.clear();
+	vd.parent_sprites_to_sort.clear();
+	vd.child_screen_sprites_to_draw.clear();
+}
+
+/**
+ * Load the sprites needed to draw the collected sprites of a part of a viewport.
+ * @param vd The collected sprites.
+ */
+static void ViewportPrefetchSprites(const ViewportDrawer &vd)
+{
+	for (const TileSpriteToDraw &ts : vd.tile_sprites_to_draw) PrefetchSpriteViewport(ts.image, ts.pal);
+	for (const ParentSpriteToDraw &ps : vd.parent_sprites_to_draw) {
+		if (ps.image != SPR_EMPTY_BOUNDING_BOX) PrefetchSpriteViewport(ps.image, ps.pal);
+	}
+	for (const ChildScreenSpriteToDraw &cs : vd.child_screen_sprites_to_draw) PrefetchSpriteViewport(cs.image, cs.pal);
+}
+
+/** Threads that help the drawing thread with sorting and drawing the sprites of parts of a viewport. */
+class ViewportDrawWorkers {
+	std::vector<std::thread> threads; ///< The worker threads.
+	std::mutex mutex; ///< Lock for the state below.
+	std::condition_variable work_available; ///< Signalled when there is new work, or the threads should stop.
+	std::condition_variable work_done; ///< Signalled when the last thread finished the work.
+	const std::function<void()> *work = nullptr; ///< The current work.
+	uint generation = 0; ///< Incremented for every new piece of work.
+	uint busy = 0; ///< Number of threads still doing the current work.
+	bool stop = false; ///< Whether the threads should stop.
+
+	/**
+	 * The loop of a worker thread.
+	 * @param generation The generation of the last work that was handed out before the thread was started.
+	 */
+	void Loop(uint generation)
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		for (;;) {
+			this->work_available.wait(lock, [this, generation]() { return this->stop || this->generation != generation; });
+			if (this->stop) return;
+			generation = this->generation;
+
+			lock.unlock();
+			(*this->work)();
+			lock.lock();
+
+			if (--this->busy == 0) this->work_done.notify_one();
+		}
+	}
+
+public:
+	~ViewportDrawWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stop = true;
+		}
+		this->work_available.notify_all();
+		for (std::thread &thread : this->threads) thread.join();
+	}
+
+	/**
+	 * Let all worker threads and the calling thread do a piece of work, and wait till they are all done.
+	 * The work has to hand out parts of itself to whichever thread asks first.
+	 * @param work The work to do.
+	 */
+	void Run(const std::function<void()> &work)
+	{
+		if (this->threads.empty()) {
+			uint count = std::max(std::thread::hardware_concurrency(), 1U) - 1;
+			for (uint i = 0; i < count; i++) {
+				std::thread thread;
+				if (!StartNewThread(&thread, "ottd:viewport", [this, generation = this->generation]() { this->Loop(generation); })) break;
+				this->threads.push_back(std::move(thread));
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->work = &work;
+			this->busy = static_cast<uint>(this->threads.size());
+			this->generation++;
+		}
+		this->work_available.notify_all();
+
+		work();
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->work_done.wait(lock, [this]() { return this->busy == 0; });
+		this->work = nullptr;
+	}
+};
+
+static ViewportDrawWorkers _viewport_draw_workers;
+
+/** Size of the squares, in pixels, into which large parts of viewports are split to draw them with multiple threads. */
+static const int VIEWPORT_DRAW_TILE_SIZE = 256;
+
+/**
+ * Check whether multiple threads can draw viewports.
+ * @return True iff the sprites can be drawn by multiple threads.
+ */
+static bool CanDrawViewportInParallel()
+{
+	/* The 32bpp blitters do not change any state while drawing a sprite. */
+	if (BlitterFactory::GetCurrentBlitter()->GetScreenDepth() != 32) return false;
+	/* The sprite picker records which sprites get drawn. */
+	if (_newgrf_debug_sprite_picker.mode == SPM_REDRAW) return false;
+	return std::thread::hardware_concurrency() > 1;
+}
+
+void ViewportDoDraw(const Viewport &vp, int left, int top, int right, int bottom)
+{
+	int mask = ScaleByZoom(-1, vp.zoom);
+	int width = (right - left) & mask;
+	int height = (bottom - top) & mask;
+	left &= mask;
+	top &= mask;
+
+	int tile_size = ScaleByZoom(VIEWPORT_DRAW_TILE_SIZE, vp.zoom);
+	uint columns = CeilDiv(width, tile_size);
+	uint rows = CeilDiv(height, tile_size);
+
+	if (columns * rows < 2 || !CanDrawViewportInParallel()) {
+		ViewportCollectSprites(vp, left, top, width, height);
+		ViewportDrawSprites(_vd);
+		ViewportDrawOverlay(vp, _vd.dpi);
+		ViewportDrawCollectedStrings(_vd);
+		return;
+	}
+
+	/* Collecting the sprites runs NewGRF callbacks, so that is done by this thread, one square at a time.
+	 * Afterwards all threads sort and draw the squares, as that does not change anything but the screen.
+	 * The overlay and the strings are drawn last, by this thread, as the font cache is not shared.
+	 * The overlay is drawn in one go, so its lines and station dots are not drawn once for every square. */
+	static std::vector<ViewportDrawer> tiles;
+	tiles.resize(columns * rows);
+
+	auto tile = tiles.begin();
+	for (int tile_top = top; tile_top < top + height; tile_top += tile_size) {
+		for (int tile_left = left; tile_left < left + width; tile_left += tile_size, ++tile) {
+			ViewportCollectSprites(vp, tile_left, tile_top, std::min(tile_size, left + width - tile_left), std::min(tile_size, top + height - tile_top));
+			std::swap(_vd, *tile);
+			ViewportPrefetchSprites(*tile);
+		}
 	}
 
-	_vd.string_sprites_to_draw.clear();
-	_vd.tile_sprites_to_draw.clear();
-	_vd.parent_sprites_to_draw.clear();
-	_vd.parent_sprites_to_sort.clear();
-	_vd.child_screen_sprites_to_draw.clear();
+	{
+		SpriteCacheSharedReads shared_reads;
+		std::atomic<uint> next_tile = 0;
+		_viewport_draw_workers.Run([&next_tile]() {
+			for (uint i = next_tile++; i < tiles.size(); i = next_tile++) ViewportDrawSprites(tiles[i]);
+		});
+	}
+
+	ViewportDrawOverlay(vp, GetViewportDrawArea(vp, left, top, width, height));
+	for (ViewportDrawer &vd : tiles) ViewportDrawCollectedStrings(vd);
 }
 
 static inline void ViewportDraw(const Viewport &vp, int left, int top, int right, int bottom)
@@ -2092,6 +2484,9 @@ static bool MarkViewportDirty(const Viewport &vp, int left, int top, int right,
  */
 bool MarkAllViewportsDirty(int left, int top, int right, int bottom)
 {
+	/* The whole screen gets redrawn once caught up. */
+	if (_network_catching_up) return false;
+
 	bool dirty = false;
 
 	for (const Window *w : Window::Iterate()) {
@@ -3606,14 +4001,16 @@ Point GetViewportStationMiddle(const Viewport &vp, const Station *st)
 struct ViewportSSCSS {
 	VpSorterChecker fct_checker; ///< The check function.
 	VpSpriteSorter fct_sorter;   ///< The sorting function.
+	std::string_view name;       ///< Name of the sorter, for the benchmark.
 };
 
-/** List of sorters ordered from best to worst. */
+/** List of sorters ordered from best to worst. They all sort into the same order. */
 static const ViewportSSCSS _vp_sprite_sorters[] = {
+	{ []() { return true; /* Always available */ }, &ViewportSortParentSpritesBuckets, "buckets" },
 #ifdef WITH_SSE
-	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41 },
+	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41, "list (SSE4.1)" },
 #endif
-	{ []() { return true; /* Always available */ }, &ViewportSortParentSprites }
+	{ []() { return true; /* Always available */ }, &ViewportSortParentSprites, "list" }
 };
 
 /** Choose the "best" sprite sorter and set _vp_sprite_sorter. */
@@ -3628,6 +4025,132 @@ void InitializeSpriteSorter()
 	assert(_vp_sprite_sorter != nullptr);
 }
 
+/**
+ * Capture the sprites that get sorted while drawing the whole screen, to replay them with #BenchmarkSpriteSorters.
+ * The capture is written to a file once the screen has been drawn.
+ */
+void CaptureSpriteSorting()
+{
+	_sprite_sorting_captured.clear();
+	_sprite_sorting_capture = true;
+	MarkWholeScreenDirty();
+}
+
+/**
+ * Write the sprites captured while drawing the screen to a file, if they are being captured.
+ * Each sort is written as the number of sprites, followed by xmin, ymin, zmin, xmax, ymax and zmax of each sprite.
+ */
+void FinishSpriteSortingCapture()
+{
+	if (!_sprite_sorting_capture) return;
+	_sprite_sorting_capture = false;
+
+	std::string filename = fmt::format("{}spritesort-{:%Y%m%d-%H%M%S}.txt", FiosGetScreenshotDir(), fmt::localtime(time(nullptr)));
+	auto f = FioFOpenFile(filename, "wt", Subdirectory::None);
+	if (!f.has_value()) {
+		IConsolePrint(CC_ERROR, "Failed to open '{}' for writing.", filename);
+	} else {
+		size_t sprites = 0;
+		for (const auto &sort : _sprite_sorting_captured) {
+			fmt::print(*f, "{}\n", sort.size());
+			for (const ParentSpriteToDraw &ps : sort) {
+				fmt::print(*f, "{} {} {} {} {} {}\n", ps.xmin, ps.ymin, ps.zmin, ps.xmax, ps.ymax, ps.zmax);
+			}
+			sprites += sort.size();
+		}
+		IConsolePrint(CC_INFO, "Captured {} sorts of {} sprites in total to '{}'.", _sprite_sorting_captured.size(), sprites, filename);
+	}
+
+	_sprite_sorting_captured.clear();
+}
+
+/**
+ * Sort the sprites captured by #CaptureSpriteSorting with every sprite sorter the CPU supports,
+ * and report how long each sorter took and whether they all sorted the sprites into the same order.
+ * @param filename The file with the captured sprites.
+ * @param iterations How often to sort all captured sprites with each sorter.
+ */
+void BenchmarkSpriteSorters(const std::string &filename, uint iterations)
+{
+	size_t length;
+	std::unique_ptr<char[]> data = ReadFileToMem(filename, length, SIZE_MAX);
+	if (data == nullptr) {
+		IConsolePrint(CC_ERROR, "Failed to read '{}'.", filename);
+		return;
+	}
+
+	std::vector<std::vector<ParentSpriteToDraw>> sorts;
+	size_t sprites = 0;
+	StringConsumer consumer(std::string_view(data.get(), length));
+	for (;;) {
+		consumer.SkipUntilCharNotIn(StringConsumer::WHITESPACE_OR_NEWLINE);
+		if (!consumer.AnyBytesLeft()) break;
+
+		/* Every sprite takes at least 12 bytes, so larger counts can only come from a broken file. */
+		auto count = consumer.TryReadIntegerBase<uint32_t>(10);
+		if (!count.has_value() || *count > length / 12) {
+			IConsolePrint(CC_ERROR, "'{}' is not a sprite sorting capture.", filename);
+			return;
+		}
+
+		auto &sort = sorts.emplace_back(*count);
+		for (ParentSpriteToDraw &ps : sort) {
+			for (int32_t *value : {&ps.xmin, &ps.ymin, &ps.zmin, &ps.xmax, &ps.ymax, &ps.zmax}) {
+				consumer.SkipUntilCharNotIn(StringConsumer::WHITESPACE_OR_NEWLINE);
+				auto v = consumer.TryReadIntegerBase<int32_t>(10);
+				if (!v.has_value()) {
+					IConsolePrint(CC_ERROR, "'{}' is not a sprite sorting capture.", filename);
+					return;
+				}
+				*value = *v;
+			}
+		}
+		sprites += sort.size();
+	}
+
+	IConsolePrint(CC_INFO, "Sorting {} sorts of {} sprites in total, {} times.", sorts.size(), sprites, iterations);
+
+	/* The order of each sort by the first sorter, as indices into the captured sprites. */
+	std::vector<std::vector<size_t>> reference;
+	std::string_view reference_name;
+	ParentSpriteToSortVector psdv;
+
+	for (const auto &sorter : _vp_sprite_sorters) {
+		if (!sorter.fct_checker()) continue;
+
+		std::chrono::steady_clock::duration duration{};
+		bool same_order = true;
+		for (uint i = 0; i < iterations; i++) {
+			for (size_t n = 0; n < sorts.size(); n++) {
+				auto &sort = sorts[n];
+				psdv.clear();
+				for (ParentSpriteToDraw &ps : sort) psdv.push_back(&ps);
+
+				auto start = std::chrono::steady_clock::now();
+				sorter.fct_sorter(&psdv);
+				duration += std::chrono::steady_clock::now() - start;
+
+				if (i != 0) continue;
+				std::vector<size_t> order;
+				for (const ParentSpriteToDraw *ps : psdv) order.push_back(ps - sort.data());
+				if (reference.size() < sorts.size()) {
+					reference.push_back(std::move(order));
+				} else if (order != reference[n]) {
+					same_order = false;
+				}
+			}
+		}
+
+		if (reference_name.empty()) reference_name = sorter.name;
+		auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+		if (same_order) {
+			IConsolePrint(CC_INFO, "  {}: {}.{:03} ms", sorter.name, microseconds / 1000, microseconds % 1000);
+		} else {
+			IConsolePrint(CC_WARNING, "  {}: {}.{:03} ms, but the order differs from '{}'", sorter.name, microseconds / 1000, microseconds % 1000, reference_name);
+		}
+	}
+}
+
 /**
  * Scroll players main viewport.
  * @param flags type of operation
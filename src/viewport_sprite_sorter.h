@@ -44,11 +44,17 @@ typedef bool (*VpSorterChecker)();
 /** Type for the actual viewport sprite sorter. */
 typedef void (*VpSpriteSorter)(ParentSpriteToSortVector *psd);
 
+void ViewportSortParentSprites(ParentSpriteToSortVector *psdv);
+void ViewportSortParentSpritesBuckets(ParentSpriteToSortVector *psdv);
+
 #ifdef WITH_SSE
 bool ViewportSortParentSpritesSSE41Checker();
 void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv);
 #endif
 
 void InitializeSpriteSorter();
+void CaptureSpriteSorting();
+void FinishSpriteSortingCapture();
+void BenchmarkSpriteSorters(const std::string &filename, uint iterations);
 
 #endif /* VIEWPORT_SPRITE_SORTER_H */
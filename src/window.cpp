@@ -13,6 +13,7 @@
 #include "console_func.h"
 #include "console_gui.h"
 #include "viewport_func.h"
+#include "viewport_sprite_sorter.h"
 #include "progress.h"
 #include "blitter/factory.hpp"
 #include "zoom_func.h"
@@ -3190,6 +3191,9 @@ void UpdateWindows()
 		_newgrf_debug_sprite_picker.mode = SPM_NONE;
 		InvalidateWindowData(WC_SPRITE_ALIGNER, 0, 1);
 	}
+
+	/* The screen is drawn, so the sprites sorted for it are captured. */
+	FinishSpriteSortingCapture();
 }
 
 /**